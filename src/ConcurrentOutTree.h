@@ -0,0 +1,350 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	//=== Epoch-based reclamation: memory retired by a writer is released once no reader can reach it ===//
+	//   A reader publishes the global epoch in a slot for the duration of its read section. Retired memory
+	//   is tagged with the epoch current when it was unlinked, and released once every published epoch is
+	//   newer (a reader entering later can no longer find it).
+	class EpochDomain
+	{
+	public:
+		using epoch_type     = std::uint64_t;
+		using free_function  = void (*)(void*);
+
+	private:
+		// Reader slot on its own cache line (0 = free)
+		struct alignas(64) Slot
+		{
+			std::atomic<epoch_type> nEpoch{};
+		};
+
+		// Memory waiting for the readers to move on
+		struct Retired
+		{
+			epoch_type nEpoch;
+			free_function fFree;
+			void* pMemory;
+		};
+
+	private:
+		std::unique_ptr<Slot[]> pSlots;
+		std::size_t nSlots;
+		std::atomic<epoch_type> nEpoch{ 1 };
+		std::vector<Retired> vRetired;  // Writer side only
+
+
+	public:
+		//=== Read section pinning the epoch current at its start ===//
+		class Guard
+		{
+		private:
+			Slot* pSlot{};
+
+		public:
+			// Default constructor: pins nothing
+			Guard() = default;
+			// Constructor pinning the current epoch of domain_
+			explicit Guard(EpochDomain& domain_) : pSlot{ domain_.pin() } {}
+			// Move constructor
+			Guard(Guard&& other_) noexcept : pSlot{ std::exchange(other_.pSlot, nullptr) } {}
+			// Move assignment operator
+			Guard& operator =(Guard&& other_) noexcept
+			{
+				if (this != &other_) {
+					release();
+					pSlot = std::exchange(other_.pSlot, nullptr);
+				}
+				return *this;
+			}
+			// Destructor: ends the read section
+			~Guard()
+			{
+				release();
+			}
+
+			// Ends the read section early
+			void release() noexcept
+			{
+				if (pSlot) {
+					std::exchange(pSlot, nullptr)->nEpoch.store(0, std::memory_order_release);
+				}
+			}
+		};
+
+
+	public:
+		// Constructor with the number of reader slots (0 selects 4 per hardware thread, at least 64)
+		explicit EpochDomain(std::size_t slots_ = 0)
+			: nSlots{ slots_ ? slots_ : (std::max)(std::size_t{ 64 }, 4 * static_cast<std::size_t>(std::thread::hardware_concurrency())) }
+		{
+			pSlots = std::make_unique<Slot[]>(nSlots);
+		}
+		// Deleted constructors and operators
+		EpochDomain(const EpochDomain&) = delete;
+		EpochDomain& operator =(const EpochDomain&) = delete;
+		// Destructor: releases all retired memory (no read section may still be open)
+		~EpochDomain()
+		{
+			for (auto& retired_ : vRetired) { retired_.fFree(retired_.pMemory); }
+		}
+
+	public:
+		// Retires memory unlinked by the writer; free_(memory_) is called once no reader can hold it
+		void retire(void* memory_, free_function free_)
+		{
+			vRetired.push_back({ nEpoch.load(std::memory_order_seq_cst), free_, memory_ });
+		}
+
+		// Advances the epoch and releases the retired memory that no read section can reach (writer only)
+		// Returns the number of released entries
+		std::size_t reclaim()
+		{
+			if (vRetired.empty()) { return 0; }
+			auto oldest_ = nEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+			for (std::size_t i_{}; i_ != nSlots; ++i_) {
+				const auto epoch_ = pSlots[i_].nEpoch.load(std::memory_order_seq_cst);
+				if (epoch_ and (epoch_ < oldest_)) { oldest_ = epoch_; }
+			}
+			const auto kept_ = std::partition(vRetired.begin(), vRetired.end(),
+				[oldest_](const Retired& retired_) { return retired_.nEpoch >= oldest_; });
+			const auto released_ = static_cast<std::size_t>(vRetired.end() - kept_);
+			for (auto it_ = kept_; it_ != vRetired.end(); ++it_) { it_->fFree(it_->pMemory); }
+			vRetired.erase(kept_, vRetired.end());
+			return released_;
+		}
+
+		// Returns the number of retired entries not released yet
+		std::size_t pending() const
+		{
+			return vRetired.size();
+		}
+
+	private:
+		// Claims a free slot and publishes the current epoch in it
+		Slot* pin()
+		{
+			auto index_ = std::hash<std::thread::id>{}(std::this_thread::get_id()) % nSlots;
+			for (std::size_t tried_{ 1 };; ++tried_, index_ = (index_ + 1) % nSlots) {
+				epoch_type free_{};
+				if (pSlots[index_].nEpoch.compare_exchange_strong(free_, nEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst)) {
+					// The links read from now on are at least as new as the published epoch
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					return &pSlots[index_];
+				}
+				if (!(tried_ % nSlots)) { std::this_thread::yield(); }  // Every slot is taken
+			}
+		}
+	};
+
+
+
+	//=== Forest traversed lock-free by any number of readers while one writer at a time modifies it ===//
+	//   Readers walk forward (as_flat(), as_preorder() and the views of their nodes) inside a read section.
+	//   The writer links new nodes and detaches removed subtrees without touching their own links, so a
+	//   reader standing in a removed subtree still finds its way back; the subtree is deleted once every
+	//   read section that could see it has ended.
+	//   Appenders (emplace_back) run alongside readers and each other, and wait only for the write section;
+	//   a reader may miss the nodes appended after one still in progress (see concurrent_emplace_back).
+	//   Limits while readers are active: values must not be modified in place, nodes are not moved,
+	//   and sizes and child counts seen by readers may lag the links.
+	template <typename T>
+	class ConcurrentContainer
+	{
+	public:
+		// Standard type aliases
+		using self_type        = ConcurrentContainer;
+		using container_type   = Container<T, ConcurrentTraits<T>>;
+		using value_type       = typename container_type::value_type;
+		using const_reference  = typename container_type::const_reference;
+		using size_type        = typename container_type::size_type;
+
+		// Iterator types of the underlying container
+		template <bool B, typename U> using generic_iterator  = typename container_type::template generic_iterator<B, U>;
+		template <typename U> using iterator                  = typename container_type::template iterator<U>;
+
+	private:
+		// Node management type aliases
+		using Node          = typename container_type::Node;
+		using node_pointer  = typename container_type::node_pointer;
+
+	private:
+		container_type cTree;
+		mutable EpochDomain dEpochs;
+		mutable std::shared_mutex mWriter;  // Exclusive for the write section, shared among appenders
+
+
+	public:
+		//=== Read section: the container may be traversed forward until the section ends ===//
+		class ReadSection
+		{
+		private:
+			EpochDomain::Guard gEpoch;
+			const container_type* pTree;
+
+		public:
+			// Constructor pinning the current epoch of owner_
+			explicit ReadSection(const self_type& owner_) : gEpoch{ owner_.dEpochs }, pTree{ &owner_.cTree } {}
+
+			// Access to the container
+			const container_type& operator *() const
+			{
+				return *pTree;
+			}
+			const container_type* operator ->() const
+			{
+				return pTree;
+			}
+		};
+
+		//=== Write section: holds the writer lock, releases unreachable subtrees when it ends ===//
+		class WriteSection
+		{
+		private:
+			std::unique_lock<std::shared_mutex> lWriter;
+			self_type* pOwner;
+
+		public:
+			// Constructor taking the writer lock of owner_
+			explicit WriteSection(self_type& owner_) : lWriter{ owner_.mWriter }, pOwner{ &owner_ } {}
+			// Destructor: reclaims what the readers have moved past (ConcurrentContainer::reclaim() does so
+			// between write sections, once long read sections have ended)
+			~WriteSection()
+			{
+				pOwner->dEpochs.reclaim();
+			}
+
+		public:
+			// Read access to the container (for navigation; modify it through this section only)
+			const container_type& operator *() const
+			{
+				return pOwner->cTree;
+			}
+			const container_type* operator ->() const
+			{
+				return &pOwner->cTree;
+			}
+
+			// @brief  Inserts a copy of value_ before the position indicated by 'where_'.
+			// @return  An iterator to the new element.
+			template <bool B, typename U>
+			iterator<U> insert(generic_iterator<B, U> where_, const_reference value_)
+			{
+				return pOwner->cTree.insert(where_, value_);
+			}
+			// @brief  Inserts value_ by move before the position indicated by 'where_'.
+			// @return  An iterator to the new element.
+			template <bool B, typename U>
+			iterator<U> insert(generic_iterator<B, U> where_, value_type&& value_)
+			{
+				return pOwner->cTree.insert(where_, std::move(value_));
+			}
+			// @brief  Constructs an element in place before the position indicated by 'where_'.
+			// @return  An iterator to the new element.
+			template <bool B, typename U, typename... Args>
+			iterator<U> emplace(generic_iterator<B, U> where_, Args&&... args)
+			{
+				return pOwner->cTree.emplace(where_, std::forward<Args>(args)...);
+			}
+
+			// @brief  Removes the node (and its subtree) indicated by 'it_'; its memory is released once
+			//         the read sections that may stand in it have ended.
+			// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+			template <bool B, typename U>
+			void remove(generic_iterator<B, U> it_)
+			{
+				container_type::validate_source(it_);
+				pOwner->retire(Node::detach(it_.base()));
+			}
+
+			// Removes every node
+			void clear()
+			{
+				while (!pOwner->cTree.empty()) {
+					remove(pOwner->cTree.as_flat().begin());
+				}
+			}
+		};
+
+
+	public:
+		// Default constructor: an empty forest
+		ConcurrentContainer() = default;
+		// Constructor taking over a container
+		explicit ConcurrentContainer(container_type&& tree_) : cTree{ std::move(tree_) } {}
+		// Deleted constructors and operators
+		ConcurrentContainer(const self_type&) = delete;
+		self_type& operator =(const self_type&) = delete;
+
+	public:
+		// Starts a read section (lock-free; any number may be open at once)
+		ReadSection read() const
+		{
+			return ReadSection(*this);
+		}
+
+		// Starts the write section (waits for the current writer, never for readers)
+		WriteSection write()
+		{
+			return WriteSection(*this);
+		}
+
+		// @brief  Constructs an element as the last child of 'parent_' (an iterator without a node appends at
+		//         the top level); lock-free against readers and other appenders. Readers see the new node
+		//         once every earlier append to the same parent has linked its node.
+		// @return  An iterator to the new element.
+		template <bool B, typename U, typename... Args>
+		iterator<U> emplace_back(generic_iterator<B, U> parent_, Args&&... args)
+		{
+			std::shared_lock<std::shared_mutex> lock_(mWriter);
+			return cTree.concurrent_emplace_back(parent_, std::forward<Args>(args)...);
+		}
+
+		// @brief  Releases the removed subtrees that no read section can reach any more, without waiting
+		//         for the next write section to end (waits for the current writer, never for readers).
+		// @return  The number of subtrees released.
+		size_type reclaim()
+		{
+			std::unique_lock<std::shared_mutex> lock_(mWriter);
+			return static_cast<size_type>(dEpochs.reclaim());
+		}
+
+		// Returns the number of removed subtrees still waiting for readers
+		size_type pending_reclamation() const
+		{
+			std::shared_lock<std::shared_mutex> lock_(mWriter);
+			return static_cast<size_type>(dEpochs.pending());
+		}
+
+	private:
+		// Hands a detached subtree to the epoch domain
+		void retire(node_pointer node_)
+		{
+			dEpochs.retire(static_cast<void*>(node_), [](void* memory_) {
+				Node::destroy_detached(static_cast<node_pointer>(memory_));
+			});
+		}
+	};
+
+}
+
+
+
+// Alias for the ConcurrentContainer class template in the global namespace
+template < typename T >
+using ConcurrentOutTree = nsOutTree::ConcurrentContainer<T>;
@@ -0,0 +1,190 @@
+#pragma once
+#include <initializer_list>
+#include <ostream>
+#include <utility>
+
+#include "OutTree.h"
+#include "PersistentOutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	//=== Copy-on-write handle to a forest: copies share the nodes and a write copies only the touched path ===//
+	//   Copying a handle is O(1). The forest is held as a PersistentContainer version, so a write replaces
+	//   the handle's version by one that copies the nodes from the top level down to the changed node (each
+	//   with its array of child pointers) and shares every other subtree with the handles it was copied from.
+	//   Nothing is ever cloned as a whole and no handle inspects who else shares its nodes.
+	//   Nodes are identified by their pre-order index, as in PersistentContainer; to_container() turns the
+	//   forest back into a linked container when iterators are needed.
+	template <typename T>
+	class CowContainer
+	{
+	public:
+		// Standard type aliases
+		using self_type        = CowContainer;
+		using version_type     = PersistentContainer<T>;
+		using value_type       = typename version_type::value_type;
+		using const_reference  = typename version_type::const_reference;
+		using size_type        = typename version_type::size_type;
+
+		// Returned for absent nodes; as a parent it stands for the top level, as a position for the end
+		static constexpr size_type npos{ version_type::npos };
+
+	private:
+		version_type vTree;
+
+
+	public:
+		// Default constructor: an empty forest
+		CowContainer() = default;
+		// Constructor copying a container (one linear pass)
+		template <typename TTraits>
+		CowContainer(const Container<T, TTraits>& tree_) : vTree{ tree_ } {}
+		// Constructor taking a version
+		CowContainer(version_type tree_) : vTree{ std::move(tree_) } {}
+		// Initializer list constructor
+		CowContainer(std::initializer_list<Container<T>> list_) : CowContainer(Container<T>(list_)) {}
+		// Copy constructor: shares the nodes (also used for moves, which leave other_ sharing them)
+		CowContainer(const self_type&) = default;
+		// Copy assignment operator: shares the nodes
+		self_type& operator =(const self_type&) = default;
+		// Default destructor
+		~CowContainer() = default;
+
+	public:
+		// Read access to the current version (never copies)
+		const version_type& read() const
+		{
+			return vTree;
+		}
+		const version_type& operator *() const
+		{
+			return read();
+		}
+		const version_type* operator ->() const
+		{
+			return &read();
+		}
+
+		// @brief  Copies the forest into a linked container.
+		// @tparam TTraits  The traits of the resulting container (defaults to BasicTraits<T>).
+		template <typename TTraits = BasicTraits<T>>
+		Container<T, TTraits> to_container() const
+		{
+			return vTree.template to_container<TTraits>();
+		}
+
+		// Checks if both handles still share every node
+		bool shares(const self_type& other_) const
+		{
+			return vTree.same_version(other_.vTree);
+		}
+
+		// Returns the number of nodes
+		size_type size() const
+		{
+			return vTree.size();
+		}
+		// Checks if the forest is empty
+		bool empty() const
+		{
+			return vTree.empty();
+		}
+
+		// Returns the value of node_
+		// @throws  std::out_of_range If `node_` is out of bounds.
+		const_reference operator [](size_type node_) const
+		{
+			return vTree.value(node_);
+		}
+
+	public:
+		// @brief  Inserts value_ as child number 'position_' of 'parent_', copying the path down to 'parent_'.
+		//
+		// @param parent_    The parent node (npos for the top level).
+		// @param position_  The position among its children (npos to append).
+		// @param value_     The value of the new node.
+		// @throws  std::out_of_range If `parent_` or `position_` is out of bounds.
+		template <typename U>
+		void insert(size_type parent_, size_type position_, U&& value_)
+		{
+			vTree = vTree.insert(parent_, position_, std::forward<U>(value_));
+		}
+		// @brief  Appends value_ to the children of 'parent_' (npos for the top level).
+		template <typename U>
+		void push_back(size_type parent_, U&& value_)
+		{
+			vTree = vTree.push_back(parent_, std::forward<U>(value_));
+		}
+
+		// @brief  Removes node_ and its subtree, copying the path down to its parent.
+		// @throws  std::out_of_range If `node_` is out of bounds.
+		void remove(size_type node_)
+		{
+			vTree = vTree.remove(node_);
+		}
+
+		// @brief  Replaces the value of node_, copying the path down to it (its subtree stays shared).
+		// @throws  std::out_of_range If `node_` is out of bounds.
+		template <typename U>
+		void update(size_type node_, U&& value_)
+		{
+			vTree = vTree.update(node_, std::forward<U>(value_));
+		}
+
+		// @brief  Calls op_(value&) on a copy of the value of node_ and stores the result as update() does.
+		// @throws  std::out_of_range If `node_` is out of bounds. Nothing changes if op_ throws.
+		template <typename Operation_>
+		void modify(size_type node_, Operation_&& op_)
+		{
+			auto value_ = vTree.value(node_);
+			op_(value_);
+			update(node_, std::move(value_));
+		}
+
+		// @brief  Makes node_ and its subtree child number 'position_' of 'parent_' (see PersistentContainer::move).
+		// @throws  std::out_of_range If `node_`, `parent_` or `position_` is out of bounds.
+		// @throws  std::invalid_argument If `parent_` lies in the subtree of `node_`.
+		void move(size_type node_, size_type parent_, size_type position_)
+		{
+			vTree = vTree.move(node_, parent_, position_);
+		}
+
+		// Removes every node (other handles keep theirs)
+		void clear()
+		{
+			vTree = version_type();
+		}
+
+		// Swaps the forests of two handles
+		void swap(self_type& other_) noexcept
+		{
+			std::swap(vTree, other_.vTree);
+		}
+
+	public:
+		// Compares the contents (subtrees shared by both handles are not walked)
+		friend bool operator ==(const self_type& lhs_, const self_type& rhs_)
+		{
+			return lhs_.vTree == rhs_.vTree;
+		}
+		friend bool operator !=(const self_type& lhs_, const self_type& rhs_)
+		{
+			return !(lhs_ == rhs_);
+		}
+		// Stream output of the forest (through a linked copy)
+		friend std::ostream& operator <<(std::ostream& os_, const self_type& cow_)
+		{
+			return os_ << cow_.to_container();
+		}
+	};
+
+}
+
+
+
+// Alias for the CowContainer class template in the global namespace
+template < typename T >
+using CowOutTree = nsOutTree::CowContainer<T>;
@@ -0,0 +1,434 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "OutTree.h"
+#include "ConcurrentOutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	//=== Lock modes of multiple granularity locking ===//
+	//   IntentShared     (IS) = shared locks will be taken below
+	//   IntentExclusive  (IX) = exclusive locks will be taken below
+	//   Shared           (S)  = the subtree is read
+	//   Exclusive        (X)  = the subtree is modified
+	enum class LockMode : unsigned char
+	{
+		IntentShared,
+		IntentExclusive,
+		Shared,
+		Exclusive
+	};
+
+
+
+	//=== Table of locks keyed by address; a key's entry exists only while it is locked ===//
+	//   Compatible modes:  IS with IS, IX and S;  IX with IS and IX;  S with IS and S;  X with none.
+	class LockTable
+	{
+	private:
+		// Holders of a key in each mode
+		using counts_type = std::array<std::uint32_t, 4>;
+
+		// Keys hashed to the same shard share its mutex and wake-up
+		struct alignas(64) Shard
+		{
+			std::mutex mShard;
+			std::condition_variable cvReleased;
+			std::unordered_map<const void*, counts_type> mLocks;
+		};
+
+	private:
+		std::unique_ptr<Shard[]> pShards;
+		std::size_t nShards;
+
+
+	public:
+		// Constructor with the number of shards
+		explicit LockTable(std::size_t shards_ = 64)
+			: pShards{ std::make_unique<Shard[]>(shards_ ? shards_ : 1u) }, nShards{ shards_ ? shards_ : 1u } {}
+		// Deleted constructors and operators
+		LockTable(const LockTable&) = delete;
+		LockTable& operator =(const LockTable&) = delete;
+
+	public:
+		// Locks key_ in mode_, waiting for the incompatible holders to release it
+		void lock(const void* key_, LockMode mode_)
+		{
+			auto& shard_ = shard_of(key_);
+			std::unique_lock<std::mutex> lock_(shard_.mShard);
+			shard_.cvReleased.wait(lock_, [&shard_, key_, mode_] {
+				const auto found_ = shard_.mLocks.find(key_);
+				return (found_ == shard_.mLocks.end()) or compatible(found_->second, mode_);
+			});
+			++shard_.mLocks[key_][index(mode_)];
+		}
+
+		// Releases a lock of key_ taken in mode_
+		void unlock(const void* key_, LockMode mode_)
+		{
+			auto& shard_ = shard_of(key_);
+			{
+				std::lock_guard<std::mutex> lock_(shard_.mShard);
+				const auto found_ = shard_.mLocks.find(key_);
+				if (!--found_->second[index(mode_)]
+					and (found_->second == counts_type{})) {
+					shard_.mLocks.erase(found_);
+				}
+			}
+			shard_.cvReleased.notify_all();
+		}
+
+	private:
+		// Returns the shard of key_
+		Shard& shard_of(const void* key_)
+		{
+			return pShards[std::hash<const void*>{}(key_) % nShards];
+		}
+
+		// Position of a mode in counts_type
+		static std::size_t index(LockMode mode_)
+		{
+			return static_cast<std::size_t>(mode_);
+		}
+
+		// Checks if mode_ may join the current holders
+		static bool compatible(const counts_type& held_, LockMode mode_)
+		{
+			const auto is_ = held_[index(LockMode::IntentShared)];
+			const auto ix_ = held_[index(LockMode::IntentExclusive)];
+			const auto s_ = held_[index(LockMode::Shared)];
+			const auto x_ = held_[index(LockMode::Exclusive)];
+			switch (mode_) {
+			case LockMode::IntentShared:     return !x_;
+			case LockMode::IntentExclusive:  return !s_ and !x_;
+			case LockMode::Shared:           return !ix_ and !x_;
+			default:                         return !is_ and !ix_ and !s_ and !x_;
+			}
+		}
+	};
+
+
+
+	//=== Forest whose subtrees are locked separately, so that writers of disjoint subtrees run in parallel ===//
+	//   A section locks a node in S (read) or X (write) mode after taking IS / IX on the container and on
+	//   every ancestor from the top down; a whole-container section locks the container itself.
+	//   Subtree sizes of the common ancestors are updated through atomic counters (ConcurrentTraits).
+	//   A thread holds one section at a time. A section reads the ancestors of its node before it holds
+	//   their locks, so removed subtrees are unlinked at once but freed only when no section that was
+	//   taking its locks meanwhile can still reach them (epoch-based, see EpochDomain); a section whose
+	//   node was removed while it waited throws. The iterator passed to read() / write() must be valid
+	//   when the call starts.
+	template <typename T>
+	class LockedContainer
+	{
+	public:
+		// Standard type aliases
+		using self_type        = LockedContainer;
+		using container_type   = Container<T, ConcurrentTraits<T>>;
+		using value_type       = typename container_type::value_type;
+		using const_reference  = typename container_type::const_reference;
+		using size_type        = typename container_type::size_type;
+
+		// Iterator types of the underlying container
+		using flat_iterator        = typename container_type::flat_iterator;
+		using const_flat_iterator  = typename container_type::const_flat_iterator;
+
+	private:
+		// Node management type aliases
+		using Node          = typename container_type::Node;
+		using node_pointer  = typename container_type::node_pointer;
+
+		template <bool B, typename U> using generic_iterator  = typename container_type::template generic_iterator<B, U>;
+		template <typename U> using iterator                  = typename container_type::template iterator<U>;
+
+	private:
+		container_type cTree;
+		mutable LockTable tLocks;
+		mutable EpochDomain dEpochs;  // Pinned by sections taking their locks
+		std::mutex mRetired;          // Guards retire / reclaim of dEpochs (writers run in parallel)
+
+
+	private:
+		//=== Locks held by a section, released in reverse order ===//
+		class SectionLock
+		{
+		private:
+			LockTable* pTable{};
+			std::vector<std::pair<const void*, LockMode>> vHeld;
+
+		public:
+			// Constructor locking node_ (nullptr = the whole container) in mode_
+			// @throws  std::invalid_argument If node_ was removed while the locks were taken.
+			SectionLock(const self_type& owner_, node_pointer node_, LockMode mode_) : pTable{ &owner_.tLocks }
+			{
+				const auto intent_ = (mode_ == LockMode::Shared) ? LockMode::IntentShared : LockMode::IntentExclusive;
+				// Subtrees removed from now on stay allocated until the links below have been read
+				EpochDomain::Guard pinned_(owner_.dEpochs);
+				std::vector<const void*> path_, check_;
+				while (owner_.path_to(node_, path_)) {
+					for (auto key_ : path_) { acquire(key_, intent_); }
+					acquire(node_ ? static_cast<const void*>(node_) : owner_.root_key(), mode_);
+					// The ancestors cannot change once locked; retry if they did on the way
+					const bool linked_{ owner_.path_to(node_, check_) };
+					if (linked_ and (check_ == path_)) { return; }
+					release();
+					if (!linked_) { break; }
+				}
+				throw std::invalid_argument("Attempted to access invalid element.");
+			}
+			// Move constructor
+			SectionLock(SectionLock&& other_) noexcept
+				: pTable{ std::exchange(other_.pTable, nullptr) }, vHeld{ std::move(other_.vHeld) } {}
+			// Deleted constructors and operators
+			SectionLock(const SectionLock&) = delete;
+			SectionLock& operator =(const SectionLock&) = delete;
+			// Destructor: releases the locks
+			~SectionLock()
+			{
+				release();
+			}
+
+		private:
+			// Takes a lock and records it
+			void acquire(const void* key_, LockMode mode_)
+			{
+				pTable->lock(key_, mode_);
+				vHeld.emplace_back(key_, mode_);
+			}
+
+			// Releases the recorded locks, innermost first
+			void release() noexcept
+			{
+				for (; !vHeld.empty(); vHeld.pop_back()) { pTable->unlock(vHeld.back().first, vHeld.back().second); }
+			}
+		};
+
+
+	public:
+		//=== Read section: the subtree (or the whole container) is not modified until it ends ===//
+		class ReadSection
+		{
+		private:
+			SectionLock lLock;
+			const self_type* pOwner;
+			node_pointer pNode;
+
+		public:
+			// Constructor locking node_ (nullptr = the whole container)
+			ReadSection(const self_type& owner_, node_pointer node_)
+				: lLock{ owner_, node_, LockMode::Shared }, pOwner{ &owner_ }, pNode{ node_ } {}
+
+			// Returns an iterator to the locked node (the end iterator for a whole-container section)
+			const_flat_iterator node() const
+			{
+				return pNode ? const_flat_iterator(pNode) : pOwner->cTree.as_flat().end();
+			}
+			// Read access to the container (only the locked subtree may be visited)
+			const container_type& operator *() const
+			{
+				return pOwner->cTree;
+			}
+			const container_type* operator ->() const
+			{
+				return &pOwner->cTree;
+			}
+		};
+
+		//=== Write section: the subtree (or the whole container) belongs to this section until it ends ===//
+		class WriteSection
+		{
+		private:
+			SectionLock lLock;
+			self_type* pOwner;
+			node_pointer pNode;
+			bool bRemoved{};  // Whether the section retired a subtree
+
+		public:
+			// Constructor locking node_ (nullptr = the whole container)
+			WriteSection(self_type& owner_, node_pointer node_)
+				: lLock{ owner_, node_, LockMode::Exclusive }, pOwner{ &owner_ }, pNode{ node_ } {}
+			// Destructor: releases the removed subtrees no section can reach any more
+			~WriteSection()
+			{
+				if (bRemoved) { pOwner->reclaim(); }
+			}
+
+			// Returns an iterator to the locked node (the end iterator for a whole-container section)
+			flat_iterator node() const
+			{
+				return pNode ? flat_iterator(pNode) : pOwner->cTree.as_flat().end();
+			}
+			// Read access to the container (only the locked subtree may be visited)
+			const container_type& operator *() const
+			{
+				return pOwner->cTree;
+			}
+			const container_type* operator ->() const
+			{
+				return &pOwner->cTree;
+			}
+
+			// @brief  Constructs an element in place before 'where_', which must lie in a child list of the locked subtree.
+			// @return  An iterator to the new element.
+			// @throws  std::invalid_argument If 'where_' lies outside the locked subtree.
+			template <bool B, typename U, typename... Args>
+			iterator<U> emplace(generic_iterator<B, U> where_, Args&&... args)
+			{
+				container_type::validate_destination(where_);
+				validate_scope(Node::is_sentinel(where_.base())
+					? Node::self_from_end(where_.base())
+					: Node::get_parent(where_.base()));
+				return pOwner->cTree.emplace(where_, std::forward<Args>(args)...);
+			}
+			// @brief  Inserts value_ before 'where_', which must lie in a child list of the locked subtree.
+			// @return  An iterator to the new element.
+			// @throws  std::invalid_argument If 'where_' lies outside the locked subtree.
+			template <bool B, typename U>
+			iterator<U> insert(generic_iterator<B, U> where_, const_reference value_)
+			{
+				return emplace(where_, value_);
+			}
+			template <bool B, typename U>
+			iterator<U> insert(generic_iterator<B, U> where_, value_type&& value_)
+			{
+				return emplace(where_, std::move(value_));
+			}
+
+			// @brief  Removes a node strictly below the locked one (any node for a whole-container section); the
+			//         subtree is unlinked now and freed once no section taking its locks can reach it.
+			// @return  An iterator to the following element.
+			// @throws  std::invalid_argument If 'it_' lies outside the locked subtree or is the locked node.
+			template <bool B, typename U>
+			iterator<U> remove(generic_iterator<B, U> it_)
+			{
+				container_type::validate_source(it_);
+				if (it_.base() == pNode) {
+					throw std::invalid_argument("Attempted to modify outside the locked subtree.");
+				}
+				validate_scope(it_.base());
+				const auto node_ = it_.base();
+				const auto following_ = std::next(flat_iterator(node_)).base();
+				Node::unlink(node_);  // Resets the node's own links: sections still on their way see it unlinked
+				pOwner->retire(node_);
+				bRemoved = true;
+				return iterator<U>(following_);
+			}
+
+		private:
+			// Checks that node_ lies in the locked subtree
+			void validate_scope(node_pointer node_) const
+			{
+				if (pNode and (Node::is_root(node_) or !Node::is_descendant(node_, pNode))) {
+					throw std::invalid_argument("Attempted to modify outside the locked subtree.");
+				}
+			}
+		};
+
+
+	public:
+		// Default constructor: an empty forest
+		LockedContainer() = default;
+		// Constructor taking over a container
+		explicit LockedContainer(container_type&& tree_) : cTree{ std::move(tree_) } {}
+		// Deleted constructors and operators
+		LockedContainer(const self_type&) = delete;
+		self_type& operator =(const self_type&) = delete;
+
+	public:
+		// Locks the subtree of it_ for reading (S, with IS on the ancestors)
+		template <bool B, typename U>
+		ReadSection read(generic_iterator<B, U> it_) const
+		{
+			container_type::validate_source(it_);
+			return ReadSection(*this, it_.base());
+		}
+		// Locks the whole container for reading
+		ReadSection read() const
+		{
+			return ReadSection(*this, nullptr);
+		}
+
+		// Locks the subtree of it_ for writing (X, with IX on the ancestors)
+		template <bool B, typename U>
+		WriteSection write(generic_iterator<B, U> it_)
+		{
+			container_type::validate_source(it_);
+			return WriteSection(*this, it_.base());
+		}
+		// Locks the whole container for writing (needed to add or remove top-level nodes)
+		WriteSection write()
+		{
+			return WriteSection(*this, nullptr);
+		}
+
+		// Returns the total number of nodes (may lag the writers still running)
+		size_type size() const
+		{
+			return cTree.size();
+		}
+
+		// @brief  Releases the removed subtrees that no section taking its locks can reach any more
+		//         (write sections that removed nodes do so when they end).
+		// @return  The number of subtrees released.
+		size_type reclaim()
+		{
+			std::lock_guard<std::mutex> lock_(mRetired);
+			return static_cast<size_type>(dEpochs.reclaim());
+		}
+
+	private:
+		// Key of the whole container
+		const void* root_key() const
+		{
+			return static_cast<const void*>(&cTree);
+		}
+
+		// Collects in path_ the keys to take intention locks on before node_: the container, then its ancestors from the top
+		// @return  false if node_ lies in a removed subtree (whose unlinked root is its own parent)
+		bool path_to(node_pointer node_, std::vector<const void*>& path_) const
+		{
+			path_.clear();
+			if (node_) {
+				for (auto it_ = node_;; ) {
+					const auto parent_ = Node::get_parent(it_);
+					if (parent_ == it_) { return false; }
+					if (Node::is_root(parent_)) { break; }
+					path_.push_back(static_cast<const void*>(parent_));
+					it_ = parent_;
+				}
+				path_.push_back(root_key());
+				std::reverse(path_.begin(), path_.end());
+			}
+			return true;
+		}
+
+		// Hands an unlinked subtree to the epoch domain
+		void retire(node_pointer node_)
+		{
+			std::lock_guard<std::mutex> lock_(mRetired);
+			dEpochs.retire(static_cast<void*>(node_), [](void* memory_) {
+				Node::destroy_detached(static_cast<node_pointer>(memory_));
+			});
+		}
+	};
+
+}
+
+
+
+// Alias for the LockedContainer class template in the global namespace
+template < typename T >
+using LockedOutTree = nsOutTree::LockedContainer<T>;
@@ -0,0 +1,698 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "OutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	template <typename> class MappedContainer;
+	template <typename, typename> class MappedIterator;
+
+
+
+	//=== Read-only mapping of a whole file into memory ===//
+	class MappedFile
+	{
+	private:
+		const unsigned char* pData{};
+		std::size_t nSize{};
+#ifdef _WIN32
+		HANDLE hFile{ INVALID_HANDLE_VALUE };
+		HANDLE hMapping{};
+#endif
+
+	public:
+		// Default constructor: maps nothing
+		MappedFile() = default;
+
+		// Constructor mapping the file at path_
+		// @throws  std::runtime_error If the file cannot be opened or mapped.
+		explicit MappedFile(const std::string& path_)
+		{
+#ifdef _WIN32
+			hFile = ::CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (hFile == INVALID_HANDLE_VALUE) {
+				throw std::runtime_error("Failed to open the mapped file.");
+			}
+			LARGE_INTEGER size_{};
+			if (!::GetFileSizeEx(hFile, &size_)) {
+				close();
+				throw std::runtime_error("Failed to query the size of the mapped file.");
+			}
+			nSize = static_cast<std::size_t>(size_.QuadPart);
+			if (nSize == 0) { return; }
+			hMapping = ::CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!hMapping) {
+				close();
+				throw std::runtime_error("Failed to map the file.");
+			}
+			pData = static_cast<const unsigned char*>(::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+			if (!pData) {
+				close();
+				throw std::runtime_error("Failed to map the file.");
+			}
+#else
+			const int fd_ = ::open(path_.c_str(), O_RDONLY);
+			if (fd_ < 0) {
+				throw std::runtime_error("Failed to open the mapped file.");
+			}
+			struct stat stat_{};
+			if (::fstat(fd_, &stat_) != 0) {
+				::close(fd_);
+				throw std::runtime_error("Failed to query the size of the mapped file.");
+			}
+			nSize = static_cast<std::size_t>(stat_.st_size);
+			if (nSize != 0) {
+				void* data_ = ::mmap(nullptr, nSize, PROT_READ, MAP_SHARED, fd_, 0);
+				if (data_ == MAP_FAILED) {
+					::close(fd_);
+					throw std::runtime_error("Failed to map the file.");
+				}
+				pData = static_cast<const unsigned char*>(data_);
+			}
+			::close(fd_);  // The mapping stays valid without the descriptor
+#endif
+		}
+
+		// Destructor: unmaps the file
+		~MappedFile()
+		{
+			close();
+		}
+
+		// Deleted copy operations
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator =(const MappedFile&) = delete;
+
+		// Move constructor
+		MappedFile(MappedFile&& other_) noexcept
+		{
+			*this = std::move(other_);
+		}
+
+		// Move assignment operator
+		MappedFile& operator =(MappedFile&& other_) noexcept
+		{
+			if (this == &other_) { return *this; }
+			close();
+			pData = std::exchange(other_.pData, nullptr);
+			nSize = std::exchange(other_.nSize, 0u);
+#ifdef _WIN32
+			hFile = std::exchange(other_.hFile, INVALID_HANDLE_VALUE);
+			hMapping = std::exchange(other_.hMapping, nullptr);
+#endif
+			return *this;
+		}
+
+	public:
+		// Returns the first mapped byte
+		const unsigned char* data() const
+		{
+			return pData;
+		}
+
+		// Returns the number of mapped bytes
+		std::size_t size() const
+		{
+			return nSize;
+		}
+
+	private:
+		// Releases the mapping and the handles
+		void close() noexcept
+		{
+#ifdef _WIN32
+			if (pData) { ::UnmapViewOfFile(pData); }
+			if (hMapping) { ::CloseHandle(hMapping); }
+			if (hFile != INVALID_HANDLE_VALUE) { ::CloseHandle(hFile); }
+			hMapping = nullptr;
+			hFile = INVALID_HANDLE_VALUE;
+#else
+			if (pData) { ::munmap(const_cast<unsigned char*>(pData), nSize); }
+#endif
+			pData = nullptr;
+			nSize = 0u;
+		}
+	};
+
+
+
+	//=== Read-only forest over a memory-mapped file in pre-order layout ===//
+	//   File layout (host byte order, each array aligned to at least 8 bytes):
+	//     header        magic "OTM1", sizeof(T), alignof(T), reserved, node count, top-level count
+	//     values        T[count]              values in pre-order
+	//     sizes         uint64_t[count]       subtree size of each node (itself included)
+	//     child counts  uint64_t[count]       number of direct children
+	//     parents       uint64_t[count]       pre-order index of the parent (count for top-level nodes)
+	//   Nodes are addressed by their pre-order index: the first child of i is i + 1, its next sibling
+	//   is i + sizes[i]. Opening a file checks these arrays in one linear pass and allocates nothing.
+	template <typename T>
+	class MappedContainer
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "MappedOutTree requires a trivially copyable value type.");
+
+	public:
+		// Standard type aliases
+		using self_type        = MappedContainer;
+		using value_type       = T;
+		using const_pointer    = const T*;
+		using const_reference  = const T&;
+		using size_type        = std::size_t;
+		using difference_type  = std::ptrdiff_t;
+
+		// Index of the virtual root above the top-level nodes
+		static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+
+	public:
+		//=== Traverse policies, moving between pre-order indices ===//
+		struct FlatTraversePolicy
+		{
+			// Returns the next sibling of index_
+			static size_type policy_next(const self_type& tree_, size_type index_, size_type)
+			{
+				return index_ + tree_.pSizes[index_];
+			}
+			// Returns the previous sibling of index_ (or the last child of origin_ for its end)
+			static size_type policy_prev(const self_type& tree_, size_type index_, size_type origin_)
+			{
+				// The previous sibling's subtree ends right before index_: climb from its last node
+				auto prev_ = index_ - 1u;
+				while (tree_.parent_of(prev_) != origin_) { prev_ = tree_.parent_of(prev_); }
+				return prev_;
+			}
+		};
+
+		struct PreorderTraversePolicy
+		{
+			// Returns the next node in pre-order
+			static size_type policy_next(const self_type&, size_type index_, size_type)
+			{
+				return index_ + 1u;
+			}
+			// Returns the previous node in pre-order
+			static size_type policy_prev(const self_type&, size_type index_, size_type)
+			{
+				return index_ - 1u;
+			}
+		};
+
+		// Iterator types
+		using const_flat_iterator              = MappedIterator<self_type, FlatTraversePolicy>;
+		using const_reverse_flat_iterator      = std::reverse_iterator<const_flat_iterator>;
+		using const_preorder_iterator          = MappedIterator<self_type, PreorderTraversePolicy>;
+		using const_reverse_preorder_iterator  = std::reverse_iterator<const_preorder_iterator>;
+
+
+	public:
+		//=== Read-only view of the children (flat) or descendants (pre-order) of a node ===//
+		template <typename TTraversePolicy>
+		class PolicyView
+		{
+		public:
+			// Iterator types of the view
+			using const_policy_iterator          = MappedIterator<self_type, TTraversePolicy>;
+			using const_reverse_policy_iterator  = std::reverse_iterator<const_policy_iterator>;
+
+		private:
+			const self_type* pTree;
+			size_type nNode;  // Root of the view (npos for the whole forest)
+
+		public:
+			// Constructor from the tree and the root index of the view
+			PolicyView(const self_type* tree_, size_type node_) : pTree{ tree_ }, nNode{ node_ } {}
+
+		public:
+			// Returns an iterator to the first node of the view
+			const_policy_iterator begin() const
+			{
+				return const_policy_iterator(pTree, pTree->begin_of(nNode), nNode);
+			}
+			// Returns an iterator past the last node of the view
+			const_policy_iterator end() const
+			{
+				return const_policy_iterator(pTree, pTree->end_of(nNode), nNode);
+			}
+			// Alias for begin()
+			const_policy_iterator cbegin() const
+			{
+				return begin();
+			}
+			// Alias for end()
+			const_policy_iterator cend() const
+			{
+				return end();
+			}
+			// Returns a reverse iterator to the last node of the view
+			const_reverse_policy_iterator rbegin() const
+			{
+				return const_reverse_policy_iterator(end());
+			}
+			// Returns a reverse iterator before the first node of the view
+			const_reverse_policy_iterator rend() const
+			{
+				return const_reverse_policy_iterator(begin());
+			}
+
+			// Returns the number of direct children of the root of the view
+			size_type child_count() const
+			{
+				return pTree->child_count_of(nNode);
+			}
+			// Returns the total number of elements below the root of the view
+			size_type size() const
+			{
+				return pTree->end_of(nNode) - pTree->begin_of(nNode);
+			}
+			// Checks if the root of the view has any children
+			bool has_children() const
+			{
+				return (child_count() != 0u);
+			}
+		};
+
+		// View aliases
+		using FlatView      = PolicyView<FlatTraversePolicy>;
+		using PreorderView  = PolicyView<PreorderTraversePolicy>;
+
+
+	private:
+		// Header of the file
+		struct header_type
+		{
+			char magic[4];
+			std::uint32_t value_size;
+			std::uint32_t value_align;
+			std::uint32_t reserved;
+			std::uint64_t count;
+			std::uint64_t top_count;
+		};
+
+		// Friend declarations
+		template <typename, typename> friend class MappedIterator;
+
+	private:
+		MappedFile mFile;
+		size_type nCount{};
+		size_type nTopCount{};
+		const T* pValues{};
+		const std::uint64_t* pSizes{};
+		const std::uint64_t* pChildCounts{};
+		const std::uint64_t* pParents{};
+
+
+	public:
+		// Default constructor: an empty forest
+		MappedContainer() = default;
+
+		// Constructor mapping a file written by write()
+		// @throws  std::runtime_error If the file cannot be mapped, does not hold a forest of T or its
+		//          sizes, child counts and parents do not describe a forest of the stored node count.
+		explicit MappedContainer(const std::string& path_) : mFile(path_)
+		{
+			header_type header_{};
+			if (mFile.size() < sizeof(header_)) {
+				throw std::runtime_error("Mapped file is too small.");
+			}
+			std::memcpy(&header_, mFile.data(), sizeof(header_));
+			if ((std::memcmp(header_.magic, magic, sizeof(header_.magic)) != 0)
+				or (header_.value_size != sizeof(T)) or (header_.value_align != alignof(T))) {
+				throw std::runtime_error("Mapped file does not hold a forest of this value type.");
+			}
+			// Every node takes sizeof(T) plus three 8-byte entries, which bounds the count before any offset is computed
+			if ((header_.count > mFile.size() / (sizeof(T) + 24u)) or (header_.top_count > header_.count)) {
+				throw std::runtime_error("Mapped file is truncated.");
+			}
+			nCount = static_cast<size_type>(header_.count);
+			nTopCount = static_cast<size_type>(header_.top_count);
+			const auto layout_ = layout(nCount);
+			if (mFile.size() < layout_.total) {
+				throw std::runtime_error("Mapped file is truncated.");
+			}
+			pValues = reinterpret_cast<const T*>(mFile.data() + layout_.values);
+			pSizes = reinterpret_cast<const std::uint64_t*>(mFile.data() + layout_.sizes);
+			pChildCounts = reinterpret_cast<const std::uint64_t*>(mFile.data() + layout_.child_counts);
+			pParents = reinterpret_cast<const std::uint64_t*>(mFile.data() + layout_.parents);
+			validate();
+		}
+
+		// Move constructor
+		MappedContainer(self_type&& other_) noexcept
+		{
+			*this = std::move(other_);
+		}
+
+		// Move assignment operator: takes over the mapping and leaves other_ empty
+		self_type& operator =(self_type&& other_) noexcept
+		{
+			if (this == &other_) { return *this; }
+			mFile = std::move(other_.mFile);
+			nCount = std::exchange(other_.nCount, 0u);
+			nTopCount = std::exchange(other_.nTopCount, 0u);
+			pValues = std::exchange(other_.pValues, nullptr);
+			pSizes = std::exchange(other_.pSizes, nullptr);
+			pChildCounts = std::exchange(other_.pChildCounts, nullptr);
+			pParents = std::exchange(other_.pParents, nullptr);
+			return *this;
+		}
+
+		// @brief  Writes a container to path_ in the layout expected by the mapping constructor.
+		//
+		// @param path_  The file to be (over)written.
+		// @param cont_  The container to be written.
+		// @throws  std::runtime_error If the file cannot be written.
+		template <typename TTraits>
+		static void write(const std::string& path_, const Container<T, TTraits>& cont_)
+		{
+			std::ofstream os_(path_, std::ios::binary | std::ios::trunc);
+			if (!os_) {
+				throw std::runtime_error("Failed to create the mapped file.");
+			}
+
+			const auto count_ = static_cast<size_type>(cont_.size());
+			const auto layout_ = layout(count_);
+			header_type header_{};
+			std::memcpy(header_.magic, magic, sizeof(header_.magic));
+			header_.value_size = sizeof(T);
+			header_.value_align = alignof(T);
+			header_.count = count_;
+			header_.top_count = cont_.child_count();
+
+			std::uint64_t offset_{};
+			auto put_ = [&os_, &offset_](const void* data_, std::size_t size_) {
+				os_.write(static_cast<const char*>(data_), static_cast<std::streamsize>(size_));
+				offset_ += size_;
+			};
+			auto pad_ = [&put_, &offset_](std::uint64_t to_) {
+				static constexpr char zeros_[64]{};
+				while (offset_ < to_) { put_(zeros_, static_cast<std::size_t>((std::min)(to_ - offset_, std::uint64_t{ sizeof(zeros_) }))); }
+			};
+
+			put_(&header_, sizeof(header_));
+			pad_(layout_.values);
+			for (const auto& value_ : cont_.pre()) { put_(&value_, sizeof(T)); }
+			pad_(layout_.sizes);
+			for (auto it_ = cont_.pre().begin(); it_ != cont_.pre().end(); ++it_) {
+				const std::uint64_t size_{ it_().size() + 1u };
+				put_(&size_, sizeof(size_));
+			}
+			for (auto it_ = cont_.pre().begin(); it_ != cont_.pre().end(); ++it_) {
+				const std::uint64_t children_{ it_().child_count() };
+				put_(&children_, sizeof(children_));
+			}
+			// Parents: open nodes with the index past their subtree, innermost last
+			std::vector<std::pair<std::uint64_t, std::uint64_t>> open_;
+			std::uint64_t index_{};
+			for (auto it_ = cont_.pre().begin(); it_ != cont_.pre().end(); ++it_, ++index_) {
+				while (!open_.empty() and (open_.back().second <= index_)) { open_.pop_back(); }
+				const std::uint64_t parent_{ open_.empty() ? count_ : open_.back().first };
+				put_(&parent_, sizeof(parent_));
+				open_.emplace_back(index_, index_ + it_().size() + 1u);
+			}
+			if (!os_.flush()) {
+				throw std::runtime_error("Failed to write the mapped file.");
+			}
+		}
+
+
+	public:
+		// Returns a view of the top-level nodes
+		FlatView as_flat() const
+		{
+			return FlatView{ this, npos };
+		}
+		// Alias for as_flat()
+		FlatView flat() const
+		{
+			return as_flat();
+		}
+		// Returns a view of all nodes in pre-order
+		PreorderView as_preorder() const
+		{
+			return PreorderView{ this, npos };
+		}
+		// Alias for as_preorder()
+		PreorderView pre() const
+		{
+			return as_preorder();
+		}
+
+		// Returns the total number of nodes
+		size_type size() const
+		{
+			return nCount;
+		}
+		// Returns the number of top-level nodes
+		size_type child_count() const
+		{
+			return nTopCount;
+		}
+		// Checks if the forest is empty
+		bool empty() const
+		{
+			return (nCount == 0u);
+		}
+
+
+	private:
+		// Magic bytes opening the file
+		static constexpr char magic[4]{ 'O', 'T', 'M', '1' };
+
+		// Offsets of the arrays of a file holding count_ nodes
+		struct layout_type
+		{
+			std::uint64_t values, sizes, child_counts, parents, total;
+		};
+		// @throws  std::length_error If the arrays of count_ nodes do not fit in 64-bit offsets.
+		static layout_type layout(std::uint64_t count_)
+		{
+			constexpr std::uint64_t align_{ alignof(T) > 8u ? alignof(T) : 8u };
+			constexpr std::uint64_t maxCount_{ (std::numeric_limits<std::uint64_t>::max() - 2u * align_ - sizeof(header_type)) / (sizeof(T) + 24u) };
+			if (count_ > maxCount_) {
+				throw std::length_error("Node count is too large for the mapped layout.");
+			}
+			auto align_up_ = [](std::uint64_t offset_, std::uint64_t to_) { return (offset_ + to_ - 1u) / to_ * to_; };
+			layout_type layout_{};
+			layout_.values = align_up_(sizeof(header_type), align_);
+			layout_.sizes = align_up_(layout_.values + count_ * sizeof(T), 8u);
+			layout_.child_counts = layout_.sizes + count_ * 8u;
+			layout_.parents = layout_.child_counts + count_ * 8u;
+			layout_.total = layout_.parents + count_ * 8u;
+			return layout_;
+		}
+
+		// Checks that every index reachable through sizes and parents stays inside the arrays and that
+		// the subtrees nest, so traversals never leave the mapping or loop
+		// @throws  std::runtime_error On the first inconsistent entry.
+		void validate() const
+		{
+			auto fail_ = []() { throw std::runtime_error("Mapped file holds an inconsistent forest."); };
+			// Index past the subtree of node_ (the whole forest for the top-level marker)
+			auto end_ = [this](std::uint64_t node_) { return (node_ == nCount) ? nCount : node_ + pSizes[node_]; };
+			for (size_type i_{}; i_ != nCount; ++i_) {
+				const auto parent_ = pParents[i_];
+				// The parent precedes the node and its subtree holds the node's subtree
+				if ((pSizes[i_] == 0u) or (pSizes[i_] > nCount - i_)) { fail_(); }
+				if ((parent_ != nCount) and (parent_ >= i_)) { fail_(); }
+				if (i_ + pSizes[i_] > end_(parent_)) { fail_(); }
+				// The first node below a parent is its child, and a node's next sibling shares its parent
+				if ((i_ + 1u < nCount) and (pSizes[i_] > 1u) and (pParents[i_ + 1u] != i_)) { fail_(); }
+				if ((i_ + pSizes[i_] < end_(parent_)) and (pParents[i_ + pSizes[i_]] != parent_)) { fail_(); }
+			}
+			if ((nCount != 0u) and (pParents[0] != nCount)) { fail_(); }
+			// Child counts match the sibling chains (each node is stepped over once)
+			auto count_children_ = [this](size_type first_, size_type last_) {
+				size_type children_{};
+				for (; first_ != last_; first_ += static_cast<size_type>(pSizes[first_])) { ++children_; }
+				return children_;
+			};
+			if (count_children_(0u, nCount) != nTopCount) { fail_(); }
+			for (size_type i_{}; i_ != nCount; ++i_) {
+				if (count_children_(i_ + 1u, i_ + static_cast<size_type>(pSizes[i_])) != pChildCounts[i_]) { fail_(); }
+			}
+		}
+
+		// Index of the first node below node_
+		size_type begin_of(size_type node_) const
+		{
+			return (node_ == npos) ? 0u : node_ + 1u;
+		}
+		// Index past the last node below node_
+		size_type end_of(size_type node_) const
+		{
+			return (node_ == npos) ? nCount : node_ + static_cast<size_type>(pSizes[node_]);
+		}
+		// Parent of node_ (npos for top-level nodes)
+		size_type parent_of(size_type node_) const
+		{
+			return (pParents[node_] == nCount) ? npos : static_cast<size_type>(pParents[node_]);
+		}
+		// Number of direct children of node_
+		size_type child_count_of(size_type node_) const
+		{
+			return (node_ == npos) ? nTopCount : static_cast<size_type>(pChildCounts[node_]);
+		}
+	};
+
+
+
+	//=== Bidirectional const iterator over a MappedContainer ===//
+	template <typename TContainer, typename TTraversePolicy>
+	class MappedIterator
+	{
+	public:
+		// Standard type aliases
+		using container_type     = TContainer;
+		using self_type          = MappedIterator;
+		using iterator_category  = std::bidirectional_iterator_tag;
+		using value_type         = typename container_type::value_type;
+		using pointer            = typename container_type::const_pointer;
+		using reference          = typename container_type::const_reference;
+		using const_pointer      = typename container_type::const_pointer;
+		using const_reference    = typename container_type::const_reference;
+		using difference_type    = typename container_type::difference_type;
+		using size_type          = typename container_type::size_type;
+
+	private:
+		// Helper aliases
+		using PolicyView  = typename container_type::template PolicyView<TTraversePolicy>;
+
+		// Friend declarations
+		template <typename, typename> friend class MappedIterator;
+
+	private:
+		const container_type* pTree{};
+		size_type nNode{ container_type::npos };    // Pre-order index of the node
+		size_type nOrigin{ container_type::npos };  // Root of the view the iterator belongs to
+
+	public:
+		// Default constructor: a null iterator
+		MappedIterator() = default;
+
+		// Constructor from the tree, the node index and the view root
+		MappedIterator(const container_type* tree_, size_type node_, size_type origin_) :
+			pTree{ tree_ }, nNode{ node_ }, nOrigin{ origin_ } {}
+
+		// Conversion from an iterator of another traversal policy (the node becomes its own origin's child)
+		template <typename T>
+		explicit MappedIterator(const MappedIterator<TContainer, T>& other_) :
+			pTree{ other_.pTree }, nNode{ other_.nNode },
+			nOrigin{ (other_.pTree and (other_.nNode < other_.pTree->size())) ? other_.pTree->parent_of(other_.nNode) : other_.nOrigin } {}
+
+	public:
+		// Dereferences the iterator
+		const_reference operator *() const
+		{
+			validate_source();
+			return pTree->pValues[nNode];
+		}
+		// Member access
+		const_pointer operator ->() const
+		{
+			return &**this;
+		}
+
+		// Pre-increment
+		self_type& operator ++()
+		{
+			nNode = TTraversePolicy::policy_next(*pTree, nNode, nOrigin);
+			return *this;
+		}
+		// Post-increment
+		self_type operator ++(int)
+		{
+			self_type captured_(*this);
+			++*this;
+			return captured_;
+		}
+		// Pre-decrement
+		self_type& operator --()
+		{
+			nNode = TTraversePolicy::policy_prev(*pTree, nNode, nOrigin);
+			return *this;
+		}
+		// Post-decrement
+		self_type operator --(int)
+		{
+			self_type captured_(*this);
+			--*this;
+			return captured_;
+		}
+
+		// Equality operator
+		friend bool operator ==(const self_type& lhs_, const self_type& rhs_)
+		{
+			return (lhs_.pTree == rhs_.pTree) and (lhs_.nNode == rhs_.nNode);
+		}
+		// Inequality operator
+		friend bool operator !=(const self_type& lhs_, const self_type& rhs_)
+		{
+			return !(lhs_ == rhs_);
+		}
+
+	public:
+		// Returns the view of the children (or descendants) of the current node
+		PolicyView operator ()() const
+		{
+			validate_source();
+			return PolicyView{ pTree, nNode };
+		}
+
+		// Returns an iterator to the parent node (a null iterator for top-level nodes)
+		self_type parent() const
+		{
+			validate_source();
+			const auto parent_ = pTree->parent_of(nNode);
+			return (parent_ == container_type::npos)
+				? self_type()
+				: self_type(pTree, parent_, pTree->parent_of(parent_));
+		}
+
+		// Returns the pre-order index of the node (its position in the mapped arrays)
+		size_type index() const
+		{
+			return nNode;
+		}
+
+	private:
+		// Checks that the iterator refers to a node
+		void validate_source() const
+		{
+			if (!pTree or (nNode >= pTree->size())) {
+				throw std::invalid_argument("Attempted to access invalid element.");
+			}
+		}
+	};
+
+}
+
+
+
+// Alias for the MappedContainer class template in the global namespace
+template < typename T >
+using MappedOutTree = nsOutTree::MappedContainer<T>;
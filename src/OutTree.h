@@ -3,6 +3,29 @@
 #include <iterator>
 #include <stdexcept>
 #include <ostream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <sstream>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <tuple>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <exception>
 
 
 
@@ -11,6 +34,8 @@ namespace nsOutTree
 
 	template < typename, bool, typename> class Iterator;
 	template <typename, typename> class Container;
+	template <typename> class ConcurrentContainer;
+	template <typename> class LockedContainer;
 
 
 
@@ -31,6 +56,765 @@ namespace nsOutTree
 
 
 
+	//=== Traits enabling the keyed child lookup (find_child) ===//
+	//   TKeyOf       = stateless callable returning the key of a value
+	//   NThreshold   = number of children above which a node keeps a hash index of its children
+	template <typename TValue, typename TKeyOf, std::size_t NThreshold = 32,
+		typename TSize = std::size_t, typename TDiff = std::ptrdiff_t>
+	struct KeyedTraits : BasicTraits<TValue, TSize, TDiff>
+	{
+		// Key extraction
+		using key_of    = TKeyOf;
+		using key_type  = std::decay_t<std::invoke_result_t<const key_of&, const TValue&>>;
+
+		// Threshold of the per-node child index
+		static constexpr TSize index_threshold{ NThreshold };
+	};
+
+
+
+	//=== Pointer stored as the distance from its own address (valid wherever its memory is mapped) ===//
+	template <typename T>
+	class OffsetPtr
+	{
+	private:
+		// Encoding of nullptr (links are pointer-aligned, so no real distance is odd)
+		static constexpr std::ptrdiff_t null_offset{ 1 };
+
+		std::ptrdiff_t nOffset{ null_offset };
+
+	public:
+		// Default constructor: nullptr
+		OffsetPtr() noexcept = default;
+		// Constructor from a raw pointer
+		explicit OffsetPtr(T* ptr_) noexcept
+		{
+			assign(ptr_);
+		}
+		// Copy constructor: the distance is recomputed for the new address
+		OffsetPtr(const OffsetPtr& other_) noexcept
+		{
+			assign(other_.get());
+		}
+
+		// Copy assignment operator
+		OffsetPtr& operator =(const OffsetPtr& other_) noexcept
+		{
+			assign(other_.get());
+			return *this;
+		}
+		// Assignment operator from a raw pointer
+		OffsetPtr& operator =(T* ptr_) noexcept
+		{
+			assign(ptr_);
+			return *this;
+		}
+
+	public:
+		// Returns the raw pointer
+		T* get() const noexcept
+		{
+			return (nOffset == null_offset)
+				? nullptr
+				: reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + nOffset);
+		}
+		// Conversion to the raw pointer
+		operator T*() const noexcept
+		{
+			return get();
+		}
+		// Dereference operators
+		T& operator *() const noexcept
+		{
+			return *get();
+		}
+		T* operator ->() const noexcept
+		{
+			return get();
+		}
+
+	private:
+		// Stores the distance from this object to ptr_
+		void assign(T* ptr_) noexcept
+		{
+			nOffset = ptr_
+				? reinterpret_cast<std::intptr_t>(ptr_) - reinterpret_cast<std::intptr_t>(this)
+				: null_offset;
+		}
+	};
+
+	//=== Pointer loaded with acquire and stored with release (links read by concurrent readers) ===//
+	template <typename T>
+	class AtomicPtr
+	{
+	private:
+		std::atomic<T*> pValue{};
+
+	public:
+		// Default constructor: nullptr
+		AtomicPtr() noexcept = default;
+		// Constructor from a raw pointer
+		explicit AtomicPtr(T* ptr_) noexcept : pValue{ ptr_ } {}
+		// Copy constructor
+		AtomicPtr(const AtomicPtr& other_) noexcept : pValue{ other_.get() } {}
+
+		// Copy assignment operator
+		AtomicPtr& operator =(const AtomicPtr& other_) noexcept
+		{
+			pValue.store(other_.get(), std::memory_order_release);
+			return *this;
+		}
+		// Assignment operator from a raw pointer
+		AtomicPtr& operator =(T* ptr_) noexcept
+		{
+			pValue.store(ptr_, std::memory_order_release);
+			return *this;
+		}
+
+	public:
+		// Returns the raw pointer
+		T* get() const noexcept
+		{
+			return pValue.load(std::memory_order_acquire);
+		}
+		// Conversion to the raw pointer
+		operator T*() const noexcept
+		{
+			return get();
+		}
+		// Dereference operators
+		T& operator *() const noexcept
+		{
+			return *get();
+		}
+		T* operator ->() const noexcept
+		{
+			return get();
+		}
+
+		// Replaces the pointer with desired_ if it still equals expected_ (otherwise loads it into expected_)
+		bool compare_exchange(T*& expected_, T* desired_) noexcept
+		{
+			return pValue.compare_exchange_weak(expected_, desired_, std::memory_order_acq_rel, std::memory_order_acquire);
+		}
+	};
+
+	//=== Counter readable while it is updated (relaxed atomic) ===//
+	template <typename T>
+	class AtomicCounter
+	{
+	private:
+		std::atomic<T> nValue{};
+
+	public:
+		// Default constructor: zero
+		AtomicCounter() noexcept = default;
+		// Constructor from a value
+		AtomicCounter(T value_) noexcept : nValue{ value_ } {}
+		// Copy constructor
+		AtomicCounter(const AtomicCounter& other_) noexcept : nValue{ T(other_) } {}
+
+		// Assignment operators
+		AtomicCounter& operator =(const AtomicCounter& other_) noexcept
+		{
+			return *this = T(other_);
+		}
+		AtomicCounter& operator =(T value_) noexcept
+		{
+			nValue.store(value_, std::memory_order_relaxed);
+			return *this;
+		}
+
+	public:
+		// Conversion to the value
+		operator T() const noexcept
+		{
+			return nValue.load(std::memory_order_relaxed);
+		}
+		// Arithmetic operators
+		AtomicCounter& operator +=(T value_) noexcept
+		{
+			nValue.fetch_add(value_, std::memory_order_relaxed);
+			return *this;
+		}
+		AtomicCounter& operator -=(T value_) noexcept
+		{
+			nValue.fetch_sub(value_, std::memory_order_relaxed);
+			return *this;
+		}
+		AtomicCounter& operator ++() noexcept
+		{
+			return *this += T{ 1 };
+		}
+		AtomicCounter& operator --() noexcept
+		{
+			return *this -= T{ 1 };
+		}
+	};
+
+	//=== Link policies: how the nodes store their links and counters ===//
+	//   RawLinkPolicy     = plain pointers (default)
+	//   OffsetLinkPolicy  = self-relative offsets (OffsetPtr), for memory mapped at different addresses
+	//   AtomicLinkPolicy  = atomic pointers and counters (AtomicPtr, AtomicCounter), for lock-free readers
+	struct RawLinkPolicy
+	{
+		template <typename T> using pointer = T*;
+		template <typename T> using counter = T;
+	};
+
+	struct OffsetLinkPolicy
+	{
+		template <typename T> using pointer = OffsetPtr<T>;
+		template <typename T> using counter = T;
+	};
+
+	struct AtomicLinkPolicy
+	{
+		template <typename T> using pointer = AtomicPtr<T>;
+		template <typename T> using counter = AtomicCounter<T>;
+	};
+
+	//=== Traits placing the nodes in an arena, e.g. a shared-memory segment used by several processes ===//
+	//   TAllocator  = stateless allocator providing static allocate(bytes, alignment) and
+	//                 deallocate(ptr, bytes, alignment) for the nodes (and the root sentinel)
+	//   Links are stored as offsets, so the segment may be mapped at a different address in each process.
+	//   Values must be relocatable themselves, the Container object must live in the segment as well,
+	//   and concurrent access requires external locking.
+	template <typename TValue, typename TAllocator, typename TSize = std::size_t, typename TDiff = std::ptrdiff_t>
+	struct RelocatableTraits : BasicTraits<TValue, TSize, TDiff>
+	{
+		using link_policy     = OffsetLinkPolicy;
+		using node_allocator  = TAllocator;
+	};
+
+	//=== Traits of a container traversed by readers while one writer links and unlinks nodes ===//
+	//   See ConcurrentContainer (ConcurrentOutTree.h), which adds epoch-based reclamation.
+	//   Several threads may also append children at once (Container::concurrent_emplace_back); see there
+	//   for what forward readers see while an append is in progress.
+	template <typename TValue, typename TSize = std::size_t, typename TDiff = std::ptrdiff_t>
+	struct ConcurrentTraits : BasicTraits<TValue, TSize, TDiff>
+	{
+		using link_policy  = AtomicLinkPolicy;
+	};
+
+	//=== Frees removed subtrees on a background thread, so that removal costs only the unlinking ===//
+	//   Entries are taken from the queue in batches. Every free function, and so every value destructor of
+	//   a deferred subtree, runs on the reclaimer's own thread (also for entries left when it is destroyed),
+	//   never on the thread that removed the nodes: destructors must not rely on its locks or thread-local state.
+	class Reclaimer
+	{
+	public:
+		using free_function = void (*)(void*);
+
+	private:
+		// Subtree waiting to be freed
+		struct Entry
+		{
+			free_function fFree;
+			void* pMemory;
+		};
+
+	private:
+		mutable std::mutex mQueue;
+		std::condition_variable cvQueued;
+		std::condition_variable cvDrained;
+		std::vector<Entry> vQueue;
+		std::size_t nInFlight{};  // Entries of the batch being freed
+		bool bStop{};
+		std::thread tWorker{ [this] { run(); } };  // Declared last: starts once the rest is ready
+
+	public:
+		// Default constructor: starts the background thread
+		Reclaimer() = default;
+		// Deleted constructors and operators
+		Reclaimer(const Reclaimer&) = delete;
+		Reclaimer& operator =(const Reclaimer&) = delete;
+		// Destructor: frees what is still queued and stops the background thread
+		~Reclaimer()
+		{
+			{
+				std::lock_guard<std::mutex> lock_(mQueue);
+				bStop = true;
+			}
+			cvQueued.notify_one();
+			tWorker.join();
+		}
+
+	public:
+		// Queues memory_ to be released by free_(memory_) on the background thread
+		void retire(void* memory_, free_function free_)
+		{
+			{
+				std::lock_guard<std::mutex> lock_(mQueue);
+				vQueue.push_back({ free_, memory_ });
+			}
+			cvQueued.notify_one();
+		}
+		// Queues every pointer of [first_, last_) to be released by free_ on the background thread (one lock for all)
+		template <typename InputIt_>
+		void retire(InputIt_ first_, InputIt_ last_, free_function free_)
+		{
+			{
+				std::lock_guard<std::mutex> lock_(mQueue);
+				for (; first_ != last_; ++first_) { vQueue.push_back({ free_, static_cast<void*>(*first_) }); }
+			}
+			cvQueued.notify_one();
+		}
+
+		// Waits until everything queued so far has been freed
+		void drain()
+		{
+			std::unique_lock<std::mutex> lock_(mQueue);
+			cvDrained.wait(lock_, [this] { return vQueue.empty() and !nInFlight; });
+		}
+
+		// Returns the number of entries not freed yet
+		std::size_t pending() const
+		{
+			std::lock_guard<std::mutex> lock_(mQueue);
+			return vQueue.size() + nInFlight;
+		}
+
+		// Returns the process-wide reclaimer (never destroyed, so containers with static storage may still use it)
+		static Reclaimer& instance()
+		{
+			static Reclaimer* shared_ = new Reclaimer();
+			return *shared_;
+		}
+
+	private:
+		// Background thread: frees the queued entries one batch at a time
+		void run()
+		{
+			std::vector<Entry> batch_;
+			std::unique_lock<std::mutex> lock_(mQueue);
+			for (;;) {
+				cvQueued.wait(lock_, [this] { return bStop or !vQueue.empty(); });
+				if (vQueue.empty()) { return; }  // Stopped with nothing left
+				batch_.swap(vQueue);
+				nInFlight = batch_.size();
+				lock_.unlock();
+				for (const auto& entry_ : batch_) { entry_.fFree(entry_.pMemory); }
+				batch_.clear();
+				lock_.lock();
+				nInFlight = 0;
+				cvDrained.notify_all();
+			}
+		}
+	};
+
+	//=== Traits of a container whose remove(), clear() and destructor free the nodes in the background ===//
+	//   reclaimer  = type providing static instance() returning the Reclaimer to use
+	//   Values are destroyed on the reclaimer's thread. Not combinable with a node_allocator (such as
+	//   RelocatableTraits): its memory must be released under the owner's lock, while the segment is mapped.
+	template <typename TValue, typename TSize = std::size_t, typename TDiff = std::ptrdiff_t>
+	struct DeferredTraits : BasicTraits<TValue, TSize, TDiff>
+	{
+		using reclaimer  = Reclaimer;
+	};
+
+	//=== Thread pool whose idle workers steal queued tasks from the busy ones ===//
+	//   Each worker pushes and pops the tasks it spawns at the back of its own queue (the most recent,
+	//   smallest pieces first) and steals from the front of the others (the oldest, largest pieces).
+	//   A thread waiting for its tasks runs queued tasks meanwhile, so tasks may wait for nested tasks,
+	//   and sleeps with the idle workers while nothing is queued.
+	class WorkStealingPool
+	{
+	public:
+		using task_type  = std::function<void()>;
+
+	private:
+		// Task queue of one worker, on its own cache line
+		struct alignas(64) Queue
+		{
+			std::mutex mQueue;
+			std::deque<task_type> dTasks;
+		};
+
+	private:
+		std::size_t nWorkers;
+		std::unique_ptr<Queue[]> pQueues;
+		std::atomic<std::size_t> nQueued{};  // Tasks pushed and not taken yet
+		std::atomic<std::size_t> nNext{};    // Queue receiving the next task submitted from outside
+		std::mutex mIdle;
+		std::condition_variable cvIdle;  // Idle workers and threads in run_until() wait here
+		bool bStop{};
+		std::vector<std::thread> vThreads;
+
+
+	public:
+		//=== Fork-join scope: tasks run through it are waited for, the first exception is rethrown ===//
+		class Group
+		{
+		private:
+			WorkStealingPool& rPool;
+			std::atomic<std::size_t> nOpen{};
+			std::atomic<bool> bFailed{};
+			std::exception_ptr pError;  // Written by the first failing task only
+
+		public:
+			// Constructor binding the group to pool_
+			explicit Group(WorkStealingPool& pool_) : rPool{ pool_ } {}
+			// Deleted constructors and operators
+			Group(const Group&) = delete;
+			Group& operator =(const Group&) = delete;
+			// Destructor: waits for the tasks still running (their exceptions are dropped)
+			~Group()
+			{
+				rPool.run_until([this] { return !nOpen.load(std::memory_order_acquire); });
+			}
+
+		public:
+			// Schedules task_() (skipped once a task of the group has thrown)
+			template <typename Task_>
+			void run(Task_&& task_)
+			{
+				nOpen.fetch_add(1, std::memory_order_relaxed);
+				rPool.submit([this, pool_ = &rPool, task_ = std::forward<Task_>(task_)]() mutable {
+					if (!bFailed.load(std::memory_order_relaxed)) {
+						try { task_(); }
+						catch (...) {
+							if (!bFailed.exchange(true)) { pError = std::current_exception(); }
+						}
+					}
+					// The group may be gone once the count reaches zero: only the pool is used past it
+					if (nOpen.fetch_sub(1, std::memory_order_acq_rel) == 1) { pool_->notify(); }
+				});
+			}
+
+			// Runs queued tasks until every task of the group has finished, then rethrows the first exception
+			void wait()
+			{
+				rPool.run_until([this] { return !nOpen.load(std::memory_order_acquire); });
+				if (pError) { std::rethrow_exception(std::exchange(pError, nullptr)); }
+			}
+		};
+
+
+	public:
+		// Constructor with the number of workers (0 selects one per hardware thread)
+		explicit WorkStealingPool(std::size_t workers_ = 0)
+			: nWorkers{ workers_ ? workers_ : (std::max)(std::size_t{ 1 }, static_cast<std::size_t>(std::thread::hardware_concurrency())) }
+		{
+			pQueues = std::make_unique<Queue[]>(nWorkers);
+			vThreads.reserve(nWorkers);
+			for (std::size_t i_{}; i_ != nWorkers; ++i_) {
+				vThreads.emplace_back([this, i_] { work(i_); });
+			}
+		}
+		// Deleted constructors and operators
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator =(const WorkStealingPool&) = delete;
+		// Destructor: runs the queued tasks and stops the workers
+		~WorkStealingPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock_(mIdle);
+				bStop = true;
+			}
+			cvIdle.notify_all();
+			for (auto& thread_ : vThreads) { thread_.join(); }
+		}
+
+	public:
+		// Returns the number of workers
+		std::size_t concurrency() const
+		{
+			return nWorkers;
+		}
+
+		// Queues task_ (on the calling worker's own queue, or spread over the queues from other threads)
+		void submit(task_type task_)
+		{
+			const auto& current_ = current();
+			const auto index_ = (current_.first == this)
+				? current_.second
+				: nNext.fetch_add(1, std::memory_order_relaxed) % nWorkers;
+			{
+				std::lock_guard<std::mutex> lock_(pQueues[index_].mQueue);
+				pQueues[index_].dTasks.push_back(std::move(task_));
+			}
+			nQueued.fetch_add(1, std::memory_order_release);
+			{
+				std::lock_guard<std::mutex> lock_(mIdle);  // A worker about to sleep sees the task first
+			}
+			cvIdle.notify_one();
+		}
+
+		// Runs queued tasks on the calling thread until done_() returns true, sleeping while none is queued
+		// (whatever makes done_() true must call notify() afterwards; Group does)
+		template <typename Done_>
+		void run_until(Done_&& done_)
+		{
+			while (!done_()) {
+				if (run_one()) { continue; }
+				std::unique_lock<std::mutex> lock_(mIdle);
+				cvIdle.wait(lock_, [this, &done_] { return nQueued.load(std::memory_order_acquire) or done_(); });
+			}
+		}
+
+		// Wakes the threads sleeping in run_until() to check their condition again
+		void notify()
+		{
+			{
+				std::lock_guard<std::mutex> lock_(mIdle);  // A thread about to sleep sees the change first
+			}
+			cvIdle.notify_all();
+		}
+
+		// Returns the process-wide pool (never destroyed, so it may be used during static destruction)
+		static WorkStealingPool& instance()
+		{
+			static WorkStealingPool* shared_ = new WorkStealingPool();
+			return *shared_;
+		}
+
+	private:
+		// Pool and queue index of the calling thread ({ nullptr, 0 } outside the workers)
+		static std::pair<const WorkStealingPool*, std::size_t>& current()
+		{
+			thread_local std::pair<const WorkStealingPool*, std::size_t> current_{};
+			return current_;
+		}
+
+		// Takes a task from the own queue (newest first) or steals one from another (oldest first), and runs it
+		bool run_one()
+		{
+			if (!nQueued.load(std::memory_order_acquire)) { return false; }
+			const auto& current_ = current();
+			const auto own_ = (current_.first == this) ? current_.second : 0u;
+			task_type task_;
+			for (std::size_t i_{}; i_ != nWorkers and !task_; ++i_) {
+				auto& queue_ = pQueues[(own_ + i_) % nWorkers];
+				std::lock_guard<std::mutex> lock_(queue_.mQueue);
+				if (queue_.dTasks.empty()) { continue; }
+				const bool owned_ = (i_ == 0) and (current_.first == this);
+				if (owned_) {
+					task_ = std::move(queue_.dTasks.back());
+					queue_.dTasks.pop_back();
+				}
+				else {
+					task_ = std::move(queue_.dTasks.front());
+					queue_.dTasks.pop_front();
+				}
+			}
+			if (!task_) { return false; }
+			nQueued.fetch_sub(1, std::memory_order_relaxed);
+			task_();
+			return true;
+		}
+
+		// Worker loop: runs tasks while there are any, sleeps otherwise
+		void work(std::size_t index_)
+		{
+			current() = { this, index_ };
+			for (;;) {
+				if (run_one()) { continue; }
+				std::unique_lock<std::mutex> lock_(mIdle);
+				cvIdle.wait(lock_, [this] { return bStop or nQueued.load(std::memory_order_acquire); });
+				if (bStop and !nQueued.load(std::memory_order_acquire)) { return; }
+			}
+		}
+	};
+
+
+
+	//=== Nested node literal consumed by Container::make() and Container::append() ===//
+	//   Holds a value and the expressions of its children; nodes are only allocated when consumed
+	template <typename TValue, typename... TChildren>
+	struct NodeExpression
+	{
+		TValue value;
+		std::tuple<TChildren...> children;
+
+		// Number of levels of the expression
+		static constexpr std::size_t depth{ 1u + (std::max)({ std::size_t{ 0 }, TChildren::depth... }) };
+	};
+
+	// Detects node expressions (depth is 0 for anything else)
+	template <typename T>
+	struct is_node_expression : std::false_type
+	{
+		static constexpr std::size_t depth{ 0 };
+	};
+	template <typename TValue, typename... TChildren>
+	struct is_node_expression<NodeExpression<TValue, TChildren...>> : std::true_type
+	{
+		static constexpr std::size_t depth{ NodeExpression<TValue, TChildren...>::depth };
+	};
+	template <typename T>
+	inline constexpr bool is_node_expression_v = is_node_expression<std::decay_t<T>>::value;
+
+	// Creates a node expression from a value and the expressions of its children
+	template <typename TValue, typename... TChildren>
+	NodeExpression<std::decay_t<TValue>, std::decay_t<TChildren>...> node(TValue&& value_, TChildren&&... children_)
+	{
+		static_assert((is_node_expression_v<TChildren> and ...), "Children must be node expressions.");
+		return {
+			std::forward<TValue>(value_),
+			std::tuple<std::decay_t<TChildren>...>(std::forward<TChildren>(children_)...)
+		};
+	}
+
+
+
+	//=== Byte sink of the binary format (see Container::serialize) ===//
+	//   Writes to a stream through an internal chunk, or appends directly to a byte string
+	class BinaryWriter
+	{
+	private:
+		// Size of the chunk collected before it is handed to the stream buffer
+		static constexpr std::size_t chunk_size{ 1u << 16 };
+
+		std::streambuf* pStream{};
+		std::string* pBuffer{};
+		std::string sChunk;
+
+	public:
+		// Constructor writing to a stream (call flush() once done)
+		explicit BinaryWriter(std::ostream& os_) : pStream{ os_.rdbuf() }, pBuffer{ &sChunk }
+		{
+			sChunk.reserve(chunk_size);
+		}
+		// Constructor appending to a byte string
+		explicit BinaryWriter(std::string& buffer_) : pBuffer{ &buffer_ } {}
+		// Deleted constructors and operators
+		BinaryWriter(const BinaryWriter&) = delete;
+		BinaryWriter& operator =(const BinaryWriter&) = delete;
+
+	public:
+		// Writes size_ raw bytes
+		void write(const void* data_, std::size_t size_)
+		{
+			pBuffer->append(static_cast<const char*>(data_), size_);
+			if (pStream and (sChunk.size() >= chunk_size)) { flush(); }
+		}
+
+		// Writes an unsigned integer as LEB128 (7 bits per byte, high bit set on all but the last byte)
+		void write_varint(std::uint64_t value_)
+		{
+			char bytes_[10];
+			std::size_t count_{};
+			for (; value_ >= 0x80u; value_ >>= 7) {
+				bytes_[count_++] = static_cast<char>((value_ & 0x7Fu) | 0x80u);
+			}
+			bytes_[count_++] = static_cast<char>(value_);
+			write(bytes_, count_);
+		}
+
+		// Hands the pending chunk to the stream
+		// @throws  std::runtime_error If the stream does not accept all bytes.
+		void flush()
+		{
+			if (!pStream or sChunk.empty()) { return; }
+			const auto size_ = static_cast<std::streamsize>(sChunk.size());
+			if (pStream->sputn(sChunk.data(), size_) != size_) {
+				throw std::runtime_error("Failed to write binary data.");
+			}
+			sChunk.clear();
+		}
+	};
+
+	//=== Byte source of the binary format (see Container::deserialize) ===//
+	//   Reads from a stream buffer (never past the serialized data) or from a byte range
+	class BinaryReader
+	{
+	private:
+		std::streambuf* pStream{};
+		const char* pCurrent{};
+		const char* pEnd{};
+
+	public:
+		// Constructor reading from a stream
+		explicit BinaryReader(std::istream& is_) : pStream{ is_.rdbuf() } {}
+		// Constructor reading from a byte range
+		explicit BinaryReader(std::string_view bytes_) : pCurrent{ bytes_.data() }, pEnd{ bytes_.data() + bytes_.size() } {}
+
+	public:
+		// Reads size_ raw bytes
+		// @throws  std::runtime_error If the data ends prematurely.
+		void read(void* data_, std::size_t size_)
+		{
+			if (pStream) {
+				if (pStream->sgetn(static_cast<char*>(data_), static_cast<std::streamsize>(size_)) != static_cast<std::streamsize>(size_)) {
+					throw std::runtime_error("Unexpected end of binary data.");
+				}
+				return;
+			}
+			if (static_cast<std::size_t>(pEnd - pCurrent) < size_) {
+				throw std::runtime_error("Unexpected end of binary data.");
+			}
+			std::memcpy(data_, pCurrent, size_);
+			pCurrent += size_;
+		}
+
+		// Reads an unsigned LEB128 integer
+		// @throws  std::runtime_error If the data ends prematurely or the value exceeds 64 bits.
+		std::uint64_t read_varint()
+		{
+			std::uint64_t value_{};
+			for (unsigned shift_{}; shift_ < 64u; shift_ += 7u) {
+				unsigned char byte_{};
+				read(&byte_, 1u);
+				value_ |= static_cast<std::uint64_t>(byte_ & 0x7Fu) << shift_;
+				if (!(byte_ & 0x80u)) { return value_; }
+			}
+			throw std::runtime_error("Malformed varint in binary data.");
+		}
+	};
+
+	//=== Value codec of the binary format; specialize it (or pass a codec object) for other types ===//
+	//   The default copies the object representation of trivially copyable types (host byte order)
+	template <typename T, typename = void>
+	struct BinaryCodec
+	{
+		static_assert(std::is_trivially_copyable_v<T>,
+			"No default binary codec for this type: specialize nsOutTree::BinaryCodec or pass a codec.");
+
+		static void write(BinaryWriter& writer_, const T& value_)
+		{
+			writer_.write(&value_, sizeof(T));
+		}
+
+		// The bytes are read into aligned storage, so T needs no default constructor
+		static T read(BinaryReader& reader_)
+		{
+			alignas(T) unsigned char bytes_[sizeof(T)];
+			reader_.read(bytes_, sizeof(T));
+			return *std::launder(reinterpret_cast<const T*>(bytes_));
+		}
+	};
+
+	// Strings of trivially copyable characters are stored as a varint length followed by the characters
+	template <typename CharT, typename TCharTraits, typename TAlloc>
+	struct BinaryCodec<std::basic_string<CharT, TCharTraits, TAlloc>, std::enable_if_t<std::is_trivially_copyable_v<CharT>>>
+	{
+		using string_type = std::basic_string<CharT, TCharTraits, TAlloc>;
+
+		static void write(BinaryWriter& writer_, const string_type& value_)
+		{
+			writer_.write_varint(value_.size());
+			writer_.write(value_.data(), value_.size() * sizeof(CharT));
+		}
+
+		static string_type read(BinaryReader& reader_)
+		{
+			const auto size_ = reader_.read_varint();
+			string_type value_;
+			// Grow in bounded steps so that a corrupt length fails on the data instead of on allocation
+			constexpr std::uint64_t step_{ 1u << 16 };
+			for (std::uint64_t done_{}; done_ < size_; ) {
+				const auto count_ = (std::min)(size_ - done_, step_);
+				value_.resize(static_cast<std::size_t>(done_ + count_));
+				reader_.read(&value_[static_cast<std::size_t>(done_)], static_cast<std::size_t>(count_) * sizeof(CharT));
+				done_ += count_;
+			}
+			return value_;
+		}
+	};
+
+
+
 	//=== Manages node-specific operations and properties for the container's structure ===//
 	template < typename TContainer >
 	class NodeManager
@@ -53,11 +837,79 @@ namespace nsOutTree
 			T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>
 		> : std::true_type {};
 
+		// Helper trait to detect the keyed child lookup in the traits
+		template <typename T, typename = void> struct key_traits : std::false_type { struct key_type {}; };
+		template <typename T> struct key_traits<
+			T, std::void_t<typename T::key_of>
+		> : std::true_type { using key_type = typename T::key_type; };
+
+		// Helper traits to detect the link policy and the node allocator in the traits
+		template <typename T, typename = void> struct link_traits { using type = RawLinkPolicy; };
+		template <typename T> struct link_traits<
+			T, std::void_t<typename T::link_policy>
+		> { using type = typename T::link_policy; };
+		template <typename T, typename = void> struct allocator_traits : std::false_type {};
+		template <typename T> struct allocator_traits<
+			T, std::void_t<typename T::node_allocator>
+		> : std::true_type {};
+
+		// Helper trait to detect the reclaimer in the traits (remove_deferred() uses the shared one otherwise)
+		template <typename T, typename = void> struct reclaimer_traits : std::false_type { using type = Reclaimer; };
+		template <typename T> struct reclaimer_traits<
+			T, std::void_t<typename T::reclaimer>
+		> : std::true_type { using type = typename T::reclaimer; };
+
+		// Smallest subtree (in nodes) worth handing to a separate thread
+		static constexpr size_type parallel_grain{ 1u << 12 };
+
+
+	public:
+		// Keyed lookup aliases (key_type is a placeholder unless the traits define key_of)
+		using traits_type  = typename TContainer::traits_type;
+		using key_type     = typename key_traits<traits_type>::key_type;
+		static constexpr bool is_keyed{ key_traits<traits_type>::value };
+
+		// Link storage (raw pointers unless the traits define link_policy)
+		using link_policy  = typename link_traits<traits_type>::type;
+		template <typename T> using link_ptr = typename link_policy::template pointer<T>;
+		template <typename T> using link_counter = typename link_policy::template counter<T>;
+		static constexpr bool is_raw_linked{ std::is_same_v<link_policy, RawLinkPolicy> };
+		static constexpr bool is_atomic_linked{ std::is_same_v<link_policy, AtomicLinkPolicy> };
+		static constexpr bool has_node_allocator{ allocator_traits<traits_type>::value };
+		static constexpr bool is_deferred{ reclaimer_traits<traits_type>::value };
+
+		static_assert(is_raw_linked or !is_keyed, "The child index is kept on the process heap and cannot be relocated.");
+
+
+	private:
+		//=== Per-node storage of the child index (empty unless the traits are keyed) ===//
+		template < typename TDerived, bool Keyed = is_keyed >
+		class IndexSlot {};
+
+		template < typename TDerived >
+		class IndexSlot<TDerived, true>
+		{
+		private:
+			// Friend declarations
+			friend class NodeManager;
+
+		private:
+			// Children of the node by key, built once nChildCount exceeds the traits threshold
+			std::unordered_multimap<key_type, link_ptr<TDerived>*>* pIndex{};
+
+		public:
+			// Destructor: releases the index
+			~IndexSlot()
+			{
+				delete pIndex;
+			}
+		};
+
 
 	private:
 		//=== Base node linkage class using CRTP ===//
 		template < typename TDerived >
-		class NodeBase
+		class NodeBase : public IndexSlot<TDerived>
 		{
 		public:
 			// Type aliases
@@ -70,38 +922,38 @@ namespace nsOutTree
 
 		private:
 			// Permanent pointer to the node itself
-			node_type* pSelf{ static_cast<node_type*>(this) };
+			link_ptr<node_type> pSelf{ static_cast<node_type*>(this) };
 
 			// Pointer to parents pSelf: 
 			//   nullptr       = root sentinel
 			//   &pSelf        = unlinked node
-			node_type** pParent{};
+			link_ptr<link_ptr<node_type>> pParent{};
 
 			// Pointer to previous siblings pSelf: 
 			//   parent->pREnd = first child
 			//   nullptr       = unlinked
-			node_type** pPrevSibling{};
+			link_ptr<link_ptr<node_type>> pPrevSibling{};
 
 			// Pointer to next siblings pSelf: 
 			//   parent->pEnd  = last child
 			//   nullptr       = unlinked
-			node_type** pNextSibling{};
+			link_ptr<link_ptr<node_type>> pNextSibling{};
 
 			// Reverse-end sentinel for child list:
 			//   pSelf         = no children
 			//   begin         = first children
-			node_type* pREnd{ pSelf };
+			link_ptr<node_type> pREnd{ pSelf };
 
 			// End sentinel for child list:
 			//   pSelf         = no children
 			//   rbegin        = last children
-			node_type* pEnd{ pSelf };
+			link_ptr<node_type> pEnd{ pSelf };
 
 			// Count of direct child nodes (immediate descendants only)
-			size_type nChildCount{};
+			link_counter<size_type> nChildCount{};
 
 			// Total nodes in subtree (includes self and all descendants)
-			size_type nSize{ 1 };
+			link_counter<size_type> nSize{ 1 };
 
 		private:
 			// Deleted constructors
@@ -182,8 +1034,9 @@ namespace nsOutTree
 		// Type aliases
 		using node_type           = typename NodeData::self_type;
 		using node_base           = typename node_type::node_base;
-		using node_pointer        = node_type**;
-		using const_node_pointer  = const node_type* const*;
+		using node_pointer        = link_ptr<node_type>*;
+		using const_node_pointer  = std::conditional_t<is_raw_linked, const node_type* const*, const link_ptr<node_type>*>;
+		using node_link           = link_ptr<link_ptr<node_type>>;  // Stored form of a node_pointer
 
 
 	public:
@@ -272,6 +1125,73 @@ namespace nsOutTree
 			os_ << "<unprintable>"; // Placeholder
 		}
 
+		// Helper constant: arithmetic types printed through std::to_chars (character types and bool excluded,
+		// as operator<< prints them differently)
+		template <typename T>
+		static constexpr bool is_to_chars_printable_v = std::is_arithmetic_v<T>
+			and !std::is_same_v<T, bool> and !std::is_same_v<T, char> and !std::is_same_v<T, signed char>
+			and !std::is_same_v<T, unsigned char> and !std::is_same_v<T, wchar_t>
+			and !std::is_same_v<T, char16_t> and !std::is_same_v<T, char32_t>;
+
+		// Helper class formatting values into a text buffer the way operator<< would: arithmetic values
+		// go through std::to_chars when the target stream uses the default format, anything else through
+		// one reused string stream carrying the format of the target stream
+		class TextFormatter
+		{
+		private:
+			std::ostringstream ssValue;
+			bool bDefaultFormat{ true };  // The target stream uses the default format
+			bool bPendingWidth{};         // The target stream has a field width, consumed by the first output
+
+		public:
+			TextFormatter() = default;
+			explicit TextFormatter(const std::ostream& os_)
+				: bDefaultFormat{ (os_.flags() == (std::ios_base::dec | std::ios_base::skipws))
+					and (os_.precision() == 6) and (os_.getloc() == std::locale::classic()) }
+				, bPendingWidth{ os_.width() != 0 }
+			{
+				ssValue.copyfmt(os_);
+			}
+
+			// Appends literal text to buf
+			void append_text(std::string& buf_, const char* text_)
+			{
+				if (bPendingWidth) { append_streamed(buf_, text_); }
+				else { buf_ += text_; }
+			}
+
+			// Appends the text of value to buf
+			template <typename T>
+			void append(std::string& buf_, const T& value_)
+			{
+				if constexpr (is_to_chars_printable_v<T>) {
+					if (bDefaultFormat and !bPendingWidth) {
+						char digits_[64];
+						if constexpr (std::is_floating_point_v<T>) {
+							// The default stream format of floating point values is printf's %g
+							buf_.append(digits_, std::to_chars(digits_, digits_ + sizeof(digits_), value_, std::chars_format::general, 6).ptr);
+						}
+						else {
+							buf_.append(digits_, std::to_chars(digits_, digits_ + sizeof(digits_), value_).ptr);
+						}
+						return;
+					}
+				}
+				append_streamed(buf_, value_);
+			}
+
+		private:
+			// Appends the text of value as printed by the string stream
+			template <typename T>
+			void append_streamed(std::string& buf_, const T& value_)
+			{
+				ssValue.str(std::string());
+				print_node_value(ssValue, value_);
+				buf_ += ssValue.str();
+				bPendingWidth = false;
+			}
+		};
+
 
 	private:
 		// Helper function to access the previous sibling const pointer
@@ -341,12 +1261,28 @@ namespace nsOutTree
 		static const_node_pointer next_preorder_raw(const_node_pointer node_, const_node_pointer end_)
 		{
 			// Descend into children if available
-			if (has_children(node_)) { return get_begin(node_); }
+			const auto begin_ = get_begin(node_);
+			if (begin_ != get_end(node_)) { return begin_; }
+			return next_preorder_skip_raw(node_, end_);
+		}
 
+		// Helper function to access the next sibling pointer
+		static node_pointer next_preorder_raw(node_pointer node_, const_node_pointer end_)
+		{
+			return const_cast<node_pointer>(
+				next_preorder_raw(
+					static_cast<const_node_pointer>(node_), end_
+				));
+		}
+
+		// Helper function to access the next const pointer in pre-order past the whole subtree of node_
+		static const_node_pointer next_preorder_skip_raw(const_node_pointer node_, const_node_pointer end_)
+		{
 			// Loop until we find the next node or reach the end
 			while (get_end(node_) != end_) {
-				// Move to the next sibling if present
-				if (!is_sentinel(next_sibling_raw(node_))) { return next_sibling_raw(node_); }
+				// Move to the next sibling if present (the link is read once)
+				const auto next_ = next_sibling_raw(node_);
+				if (!is_sentinel(next_)) { return next_; }
 				// If no children and no next sibling, go up to the parent's next sibling
 				node_ = get_parent(node_);
 			}
@@ -354,11 +1290,11 @@ namespace nsOutTree
 			return get_end(node_);
 		}
 
-		// Helper function to access the next sibling pointer
-		static node_pointer next_preorder_raw(node_pointer node_, const_node_pointer end_)
+		// Helper function to access the next pointer in pre-order past the whole subtree of node_
+		static node_pointer next_preorder_skip_raw(node_pointer node_, const_node_pointer end_)
 		{
 			return const_cast<node_pointer>(
-				next_preorder_raw(
+				next_preorder_skip_raw(
 					static_cast<const_node_pointer>(node_), end_
 				));
 		}
@@ -366,13 +1302,13 @@ namespace nsOutTree
 
 	private:
 		// Helper function to access the self const pointer
-		static const node_type*& self_raw(const_node_pointer node_)
+		static const link_ptr<node_type>& self_raw(const_node_pointer node_)
 		{
 			return (**node_).pSelf;
 		}
 
 		// Helper function to access the self pointer
-		static node_type*& self_raw(node_pointer node_)
+		static link_ptr<node_type>& self_raw(node_pointer node_)
 		{
 			return (**node_).pSelf;
 		}
@@ -408,6 +1344,61 @@ namespace nsOutTree
 		}
 
 
+	private:
+		// Helper function to extract the lookup key of a node
+		static key_type key_of(const_node_pointer node_)
+		{
+			return typename traits_type::key_of{}(data_ref(node_));
+		}
+
+		// Helper function to register node_ in the child index of parent_
+		// The index is built once the child count exceeds the traits threshold
+		static void index_link([[maybe_unused]] node_pointer parent_, [[maybe_unused]] node_pointer node_)
+		{
+			if constexpr (is_keyed) {
+				auto& index_ = (**parent_).pIndex;
+				if (index_) {
+					index_->emplace(key_of(node_), node_);
+				}
+				else if (get_child_count(parent_) > traits_type::index_threshold) {
+					index_ = new std::unordered_multimap<key_type, node_pointer>(get_child_count(parent_));
+					for (auto it_{ get_begin(parent_) }; it_ != get_end(parent_); it_ = next_sibling_raw(it_)) {
+						index_->emplace(key_of(it_), it_);
+					}
+				}
+			}
+		}
+
+		// Helper function to drop node_ from the child index of parent_
+		// The index is released again once the child count falls below half the threshold
+		static void index_unlink([[maybe_unused]] node_pointer parent_, [[maybe_unused]] node_pointer node_)
+		{
+			if constexpr (is_keyed) {
+				auto& index_ = (**parent_).pIndex;
+				if (!index_) { return; }
+				if (get_child_count(parent_) <= traits_type::index_threshold / 2) {
+					delete std::exchange(index_, nullptr);
+					return;
+				}
+				index_erase(parent_, key_of(node_), node_);
+			}
+		}
+
+		// Helper function to drop the entry of node_ filed under key_ from the child index of parent_
+		// (keys only change through modify() and the transforms, which re-file the node, so the entry is found under its key)
+		static void index_erase(node_pointer parent_, const key_type& key_, node_pointer node_)
+		{
+			auto& index_ = *(**parent_).pIndex;
+			auto [first_, last_] = index_.equal_range(key_);
+			for (; first_ != last_; ++first_) {
+				if (first_->second == node_) {
+					index_.erase(first_);
+					return;
+				}
+			}
+		}
+
+
 	private:
 		// Increases the total subtree count upwards to the root
 		// The time complexity is O(N), where N = depth of inserted node
@@ -473,12 +1464,139 @@ namespace nsOutTree
 			}
 			// Increment parent's child count
 			++(**get_parent(node_)).nChildCount;
+			index_link(get_parent(node_), node_);
 			return node_;
 		}
 
+		// Helper function to construct TNode_ in memory obtained from the traits allocator
+		template <typename TNode_, typename... Args_>
+		static node_pointer allocate_node(Args_&&... args_)
+		{
+			using allocator_ = typename traits_type::node_allocator;
+			void* memory_ = allocator_::allocate(sizeof(TNode_), alignof(TNode_));
+			try {
+				return self(::new (memory_) TNode_(std::forward<Args_>(args_)...));
+			}
+			catch (...) {
+				allocator_::deallocate(memory_, sizeof(TNode_), alignof(TNode_));
+				throw;
+			}
+		}
+
+		// Helper function to destroy TNode_ and return its memory to the traits allocator
+		template <typename TNode_>
+		static void deallocate_node(TNode_* node_) noexcept
+		{
+			node_->~TNode_();
+			traits_type::node_allocator::deallocate(static_cast<void*>(node_), sizeof(TNode_), alignof(TNode_));
+		}
+
+		// Helper function to delete every node of a subtree that is no longer linked
+		static void destroy(node_pointer node_)
+		{
+			// Traverse sub-tree in reverse order and delete them
+			for_each_reverse<PreorderTraversePolicy_>(
+				get_end(node_), node_,
+				[](node_pointer node_) {
+					destroy_node(node_);
+					return true;
+				}
+			);
+		}
+
+		// Helper function to apply op(node, position) in pre-order to the subtrees of the sibling range [first, last),
+		// whose first node is at position 'index': consecutive subtrees are batched into tasks of about 'grain' nodes,
+		// larger ones are split at their root
+		template <typename NodeTy_, typename UnOp_>
+		static void parallel_subtrees(NodeTy_ first_, NodeTy_ last_, size_type index_, UnOp_& op_, size_type grain_, WorkStealingPool::Group& group_)
+		{
+			// Visits the subtrees of [first, last) serially, from position 'index' on
+			auto serial_ = [&op_](NodeTy_ first_, NodeTy_ last_, size_type index_) {
+				for_each_depth(first_, last_, [&op_, &index_](NodeTy_ node_, size_type) { op_(node_, index_++); });
+			};
+			auto batch_ = first_;
+			auto batch_index_ = index_;
+			for (auto it_ = first_; it_ != last_; ) {
+				const auto next_ = next_sibling_raw(it_);
+				const auto size_ = get_size(it_);
+				if (size_ > grain_) {
+					if (batch_ != it_) {
+						group_.run([batch_, it_, batch_index_, serial_] { serial_(batch_, it_, batch_index_); });
+					}
+					op_(it_, index_);
+					group_.run([it_, index_, &op_, grain_, &group_] {
+						parallel_subtrees(get_begin(it_), get_end(it_), index_ + 1, op_, grain_, group_);
+					});
+					batch_ = next_;
+					batch_index_ = index_ + size_;
+				}
+				else if (index_ + size_ - batch_index_ >= grain_) {
+					group_.run([batch_, next_, batch_index_, serial_] { serial_(batch_, next_, batch_index_); });
+					batch_ = next_;
+					batch_index_ = index_ + size_;
+				}
+				index_ += size_;
+				it_ = next_;
+			}
+			serial_(batch_, last_, batch_index_);  // The remainder on the current thread
+		}
+
+		// Helper function returning the reclaimer of the traits (or the shared one)
+		static Reclaimer& reclaimer()
+		{
+			// The reclaimer's thread would return the nodes to the allocator without the lock that guards it,
+			// possibly after the segment holding them has been unmapped
+			static_assert(!has_node_allocator, "Deferred freeing (remove_deferred, DeferredTraits) is not available with a node allocator.");
+			return reclaimer_traits<traits_type>::type::instance();
+		}
+
+		// Helper function run by the reclaimer's thread on a retired subtree
+		static void destroy_retired(void* memory_)
+		{
+			destroy(static_cast<node_pointer>(memory_));
+		}
+
+		// Helper function to hand an unlinked subtree to the reclaimer
+		static void retire(node_pointer node_)
+		{
+			reclaimer().retire(static_cast<void*>(node_), &destroy_retired);
+		}
+		// Helper function to hand unlinked subtrees to the reclaimer in one batch
+		static void retire(const std::vector<node_pointer>& nodes_)
+		{
+			if (!nodes_.empty()) { reclaimer().retire(nodes_.begin(), nodes_.end(), &destroy_retired); }
+		}
+
+		// Helper function to free an unlinked subtree now, or in the background if the traits define a reclaimer
+		static void release(node_pointer node_)
+		{
+			if constexpr (is_deferred) { retire(node_); }
+			else { destroy(node_); }
+		}
+		// Helper function to free unlinked subtrees now, or in the background (in one batch) if the traits define a reclaimer
+		static void release(const std::vector<node_pointer>& nodes_)
+		{
+			if constexpr (is_deferred) { retire(nodes_); }
+			else {
+				for (auto node_ : nodes_) { destroy(node_); }
+			}
+		}
+
 		// Helper function to unlink node from its parent's sibling list
 		static node_pointer unlink_impl(node_pointer node_)
 		{
+			bypass_impl(node_);
+
+			// Reset pointers for the removed node
+			(**node_).pParent = (**node_).pPrevSibling = (**node_).pNextSibling = self(node_);
+			return node_;
+		}
+
+		// Helper function to take node out of its parent's sibling list, leaving its own links as they were
+		// (neighbours are relinked with single stores, so a forward reader sees either the old or the new list)
+		static void bypass_impl(node_pointer node_)
+		{
+			index_unlink(get_parent(node_), node_);
 			--(**get_parent(node_)).nChildCount;  // Decrement parent's child count
 
 			if (!is_sentinel(prev_sibling_raw(node_))) {
@@ -499,11 +1617,7 @@ namespace nsOutTree
 				(**get_parent(node_)).pEnd = is_sentinel(prev_sibling_raw(node_))
 					? self_raw(get_parent(node_))
 					: self_raw(prev_sibling_raw(node_));
-			}
-
-			// Reset pointers for the removed node
-			(**node_).pParent = (**node_).pPrevSibling = (**node_).pNextSibling = self(node_);
-			return node_;
+			}
 		}
 
 		// Helper function to move node before the position indicated by where_
@@ -517,14 +1631,14 @@ namespace nsOutTree
 		// Helper function to copy node before the position indicated by where_
 		static node_pointer shallow_copy_impl(const_node_pointer node_)
 		{
-			node_pointer copied_ = self(new node_type(data_ref(node_)));
+			node_pointer copied_ = create_node(data_ref(node_));
 			return copied_;
 		}
 
 		// Helper function to copy node before the position indicated by where_
 		static node_pointer deep_copy_impl(const_node_pointer node_)
 		{
-			node_pointer copied_ = self(new node_type(data_ref(node_)));
+			node_pointer copied_ = create_node(data_ref(node_));
 			if (has_children(node_)) {
 				if (!for_each<PreorderTraversePolicy_>(
 					copied_, get_end(copied_),
@@ -533,7 +1647,7 @@ namespace nsOutTree
 						// Iterate through children of rhs_ and copy them to lhs_
 						for (auto it_{ get_begin(rhs_) }; it_ != get_end(rhs_); it_ = next_sibling_raw(it_)) {
 							// Create a new node passing value as param
-							node_pointer child_ = self(new node_type(data_ref(it_)));
+							node_pointer child_ = create_node(data_ref(it_));
 							// Insert as the last child of lhs_
 							link_impl(get_end(lhs_), child_);
 						}
@@ -568,8 +1682,105 @@ namespace nsOutTree
 			);
 		}
 
+		// Helper function to compare data and counters, giving up as soon as 'cancel_' is raised
+		template <typename BinPred_>
+		static bool deep_compare_impl(const_node_pointer first_, const_node_pointer second_, BinPred_&& equal_,
+			const std::atomic<bool>& cancel_)
+		{
+			return for_each<PreorderTraversePolicy_>(
+				first_, get_end(first_),
+				second_, get_end(second_),
+				[&equal_, &cancel_](auto first_, auto second_) {
+					return !cancel_.load(std::memory_order_relaxed)
+						and (get_size(first_) == get_size(second_))
+						and (get_child_count(first_) == get_child_count(second_))
+						and equal_(data_ref(first_), data_ref(second_));
+				}
+			);
+		}
+
+		// Helper function to compare counters only
+		static bool shape_compare_impl(const_node_pointer first_, const_node_pointer second_)
+		{
+			return (get_size(first_) == get_size(second_))
+				and (get_child_count(first_) == get_child_count(second_));
+		}
+
+		// Helper function to stably sort the child list of a node by relinking it (values are not touched)
+		// The children are sorted as a vector of pointers and relinked only once sorting succeeded,
+		// so a throwing comparison leaves the list as it was
+		template <typename Compare_>
+		static void sort_children_impl(node_pointer node_, Compare_& comp_)
+		{
+			if (get_child_count(node_) < 2) { return; }
+
+			std::vector<node_pointer> children_;
+			children_.reserve(get_child_count(node_));
+			for (node_pointer it_{ get_begin(node_) }, end_{ get_end(node_) }; it_ != end_; it_ = next_sibling_raw(it_)) {
+				children_.push_back(it_);
+			}
+			std::stable_sort(children_.begin(), children_.end(),
+				[&comp_](node_pointer lhs_, node_pointer rhs_) {
+					return comp_(data_ref(const_node_pointer(lhs_)), data_ref(const_node_pointer(rhs_)));
+				});
+
+			// Relink the siblings in sorted order and restore the sentinels of the parent
+			const auto count_ = children_.size();
+			for (std::size_t i_{}; i_ != count_; ++i_) {
+				(**children_[i_]).pPrevSibling = i_ ? children_[i_ - 1] : get_rend(node_);
+				(**children_[i_]).pNextSibling = (i_ + 1 != count_) ? children_[i_ + 1] : get_end(node_);
+			}
+			(**node_).pREnd = self_raw(children_.front());
+			(**node_).pEnd = self_raw(children_.back());
+		}
+
 
 	public:
+		// Interface function to allocate and construct a node
+		template <typename... Args_>
+		static node_pointer create_node(Args_&&... args_)
+		{
+			if constexpr (has_node_allocator) {
+				return allocate_node<node_type>(std::forward<Args_>(args_)...);
+			}
+			else {
+				return self(new node_type(std::forward<Args_>(args_)...));
+			}
+		}
+
+		// Interface function to destroy and release a node (it must be unlinked)
+		static void destroy_node(node_pointer node_) noexcept
+		{
+			if constexpr (has_node_allocator) {
+				deallocate_node<node_type>(*node_);
+			}
+			else {
+				delete* node_;
+			}
+		}
+
+		// Interface function to allocate the root sentinel of a container
+		static node_pointer create_root()
+		{
+			if constexpr (has_node_allocator) {
+				return allocate_node<node_base>();
+			}
+			else {
+				return self(new node_base{});
+			}
+		}
+
+		// Interface function to release the root sentinel of a container (it must be empty)
+		static void destroy_root(node_pointer root_) noexcept
+		{
+			if constexpr (has_node_allocator) {
+				deallocate_node<node_base>(static_cast<node_base*>(*root_));
+			}
+			else {
+				delete static_cast<node_base*>(*root_);
+			}
+		}
+
 		// Interface function to link a node
 		static node_pointer link(node_pointer where_, node_pointer node_)
 		{
@@ -580,6 +1791,32 @@ namespace nsOutTree
 			return node_;
 		}
 
+		// Interface function to link an unlinked node as the last child of parent_ while other threads do the same
+		// The parent's last-child link is claimed by compare-and-swap, then the previous last child (or the
+		// parent's first-child link) is pointed at the node. Until that second store, forward readers stop at
+		// the previous last child, so this node and every node appended after it stay out of their sight for
+		// as long as this appender is delayed between the two steps (no bound if it is preempted there)
+		static node_pointer concurrent_append(node_pointer parent_, node_pointer node_)
+		{
+			static_assert(is_atomic_linked, "Concurrent appends require the atomic link policy (ConcurrentTraits).");
+			auto& parent_node_ = **parent_;
+			auto& node_ref_ = **node_;
+			node_ref_.pParent = parent_;
+			node_ref_.pNextSibling = get_end(parent_);
+
+			node_type* last_ = parent_node_.pEnd;
+			do {
+				node_ref_.pPrevSibling = (last_ == &parent_node_) ? get_rend(parent_) : self(last_);
+			} while (!parent_node_.pEnd.compare_exchange(last_, &node_ref_));
+
+			if (last_ == &parent_node_) { parent_node_.pREnd = &node_ref_; }  // First child
+			else { last_->pNextSibling = node_; }
+
+			++parent_node_.nChildCount;
+			increase_sizes_upwards(node_, get_size(node_));
+			return node_;
+		}
+
 		// Interface function to unlink node
 		static node_pointer unlink(node_pointer node_)
 		{
@@ -593,36 +1830,233 @@ namespace nsOutTree
 		{
 			auto following_ = next_sibling_raw(node_);
 			unlink(node_);
-			// Traverse sub-tree in reverse order and delete them
-			for_each_reverse<PreorderTraversePolicy_>(
-				get_end(node_), node_,
-				[](node_pointer node_) {
-					delete* node_;
-					return true;
-				}
-			);
+			release(node_);
+			return following_;
+		}
+
+		// Interface function to remove node, handing its subtree to the reclaimer instead of freeing it here
+		static node_pointer remove_deferred(node_pointer node_)
+		{
+			auto following_ = next_sibling_raw(node_);
+			unlink(node_);
+			retire(node_);
 			return following_;
 		}
 
+		// Interface function to remove every child of parent_ with its subtree, handing them to the reclaimer in one
+		// batch: only the child list is walked, and the sizes above parent_ are updated once
+		// @return  The number of removed nodes.
+		static size_type remove_children_deferred(node_pointer parent_)
+		{
+			std::vector<node_pointer> roots_;
+			roots_.reserve(get_child_count(parent_));
+			for (auto it_ = get_begin(parent_); it_ != get_end(parent_); it_ = next_sibling_raw(it_)) { roots_.push_back(it_); }
+			if (roots_.empty()) { return 0; }
+
+			// Empty the child list of parent_ (and drop its index) as if each child had been unlinked
+			const auto removed_ = get_size(parent_) - 1;
+			if constexpr (is_keyed) { delete std::exchange((**parent_).pIndex, nullptr); }
+			(**parent_).nChildCount = 0;
+			(**parent_).pREnd = self_raw(parent_);
+			(**parent_).pEnd = self_raw(parent_);
+			(**parent_).nSize -= removed_;
+			decrease_sizes_upwards(parent_, removed_);
+			for (auto node_ : roots_) {
+				(**node_).pParent = (**node_).pPrevSibling = (**node_).pNextSibling = self(node_);
+			}
+			retire(roots_);
+			return removed_;
+		}
+
+		// Interface function to unlink node while readers may stand in its subtree: the node keeps its own
+		// links (so they still lead back into the tree) and must only be released by destroy_detached()
+		static node_pointer detach(node_pointer node_)
+		{
+			decrease_sizes_upwards(node_, get_size(node_));
+			bypass_impl(node_);
+			return node_;
+		}
+
+		// Interface function to delete the subtree of a node returned by detach()
+		static void destroy_detached(node_pointer node_)
+		{
+			destroy(node_);
+		}
+
 		// Interface function to remove node in range [begin,end) if predicate
+		//
+		// Matches are unlinked in reverse pre-order (descendants before ancestors) and only the direct
+		// parent's size is adjusted at that point. The removed counts are kept on a stack of pending
+		// deltas and handed one level up when the parent itself is visited, so every ancestor is updated
+		// once per call instead of once per removed node. Detached subtrees are freed after the walk
+		// (retired to the reclaimer in one batch if the traits defer freeing).
 		template <typename TTraversePolicy, typename UnPred_>
 		static size_type remove_if(node_pointer begin_, node_pointer end_, UnPred_&& pred_)
 		{
+			return remove_nodes_if<TTraversePolicy>(
+				begin_, end_,
+				[&pred_](node_pointer node_) { return pred_(data_ref(const_node_pointer(node_))); }
+			);
+		}
+
+		// Interface function to remove the nodes a view of node traverses for which pred(value) holds,
+		// evaluating the predicate on the shared pool and unlinking the matches in one serial pass
+		template <typename TTraversePolicy, typename UnPred_>
+		static size_type parallel_remove_if(node_pointer node_, UnPred_& pred_, size_type grain_)
+		{
+			constexpr bool is_flat_{ std::is_same_v<TTraversePolicy, FlatTraversePolicy_> };
+			size_type count_{ is_flat_ ? get_child_count(node_) : get_size(node_) - 1 };
+			std::vector<unsigned char> matched_(count_);  // By position in the view (bytes, written concurrently)
+			auto mark_ = [&pred_, &matched_](node_pointer node_, size_type index_) {
+				matched_[index_] = pred_(data_ref(const_node_pointer(node_))) ? 1u : 0u;
+			};
+			parallel_for_each<TTraversePolicy>(node_, mark_, grain_);
+
+			// The serial walk visits every position once, in reverse
+			return remove_nodes_if<TTraversePolicy>(
+				get_begin(node_), get_end(node_),
+				[&matched_, &count_](node_pointer) { return matched_[--count_] != 0u; }
+			);
+		}
+
+		// Helper function of remove_if() taking a predicate on the node itself
+		template <typename TTraversePolicy, typename NodePred_>
+		static size_type remove_nodes_if(node_pointer begin_, node_pointer end_, NodePred_&& pred_)
+		{
+			struct pending_type { node_pointer node; size_type delta; };
+			std::vector<pending_type> pending_;  // Deltas still owed to the ancestors of 'node' (innermost last)
+			std::vector<node_pointer> removed_;  // Detached subtree roots
 			size_type removedCnt_{};
-			// Removes all elements for which predicate returns true
-			for_each_reverse<TTraversePolicy>(
-				end_, begin_,
-				[&removedCnt_, &pred_](node_pointer node_) {
-					if (pred_(data_ref(const_node_pointer(node_)))) {
-						removedCnt_ += get_size(node_);
-						remove(node_);
+
+			// Subtracts delta_ from the parent of node_ and records it as owed to the parent's ancestors
+			auto defer_ = [&pending_](node_pointer node_, size_type delta_) {
+				auto parent_ = get_parent(node_);
+				if (pending_.empty() or (pending_.back().node != parent_)) {
+					pending_.push_back({ parent_, 0u });
+				}
+				pending_.back().delta += delta_;
+				(**parent_).nSize -= delta_;
+			};
+
+			// Applies whatever is still owed to the ancestors above the visited nodes and frees removed nodes
+			auto settle_ = [&pending_, &removed_]() {
+				size_type carry_{};
+				if (!pending_.empty()) {
+					for (node_pointer it_{ pending_.back().node }; is_valid(it_); it_ = get_parent(it_)) {
+						(**it_).nSize -= carry_;
+						if (!pending_.empty() and (pending_.back().node == it_)) {
+							carry_ += pending_.back().delta;
+							pending_.pop_back();
+						}
 					}
-					return true;  // Continue
 				}
-			);
+				release(removed_);
+			};
+
+			try {
+				for_each_reverse<TTraversePolicy>(
+					end_, begin_,
+					[&](node_pointer node_) {
+						const bool matched_ = pred_(node_);
+						// All descendants of node_ were visited, take over what they left for it
+						size_type delta_{};
+						if (!pending_.empty() and (pending_.back().node == node_)) {
+							delta_ = pending_.back().delta;
+							pending_.pop_back();
+						}
+						if (matched_) {
+							removed_.push_back(node_);
+							removedCnt_ += get_size(node_);
+							defer_(node_, get_size(node_) + delta_);
+							unlink_impl(node_);
+						}
+						else if (delta_ != 0u) {
+							defer_(node_, delta_);
+						}
+						return true;  // Continue
+					}
+				);
+			}
+			catch (...) {
+				settle_();
+				throw;
+			}
+			settle_();
 			return removedCnt_;
 		}
 
+		//=== Appends nodes given in pre-order below a parent, with one size update per node ===//
+		class PreorderBuilder
+		{
+		private:
+			// The node receiving the top-level nodes of the sequence
+			node_pointer pParent;
+			// Nodes whose subtrees are still open, from the top-level node down to the last appended one
+			std::vector<node_pointer> vPath;
+			// Total number of nodes appended and not yet accounted for above pParent
+			size_type nAdded{};
+
+		public:
+			// Constructor from the parent node (appends after its current children)
+			explicit PreorderBuilder(node_pointer parent_) : pParent{ parent_ } {}
+			// Deleted constructors and operators
+			PreorderBuilder(const PreorderBuilder&) = delete;
+			PreorderBuilder& operator =(const PreorderBuilder&) = delete;
+			// Destructor: accounts for everything appended so far
+			~PreorderBuilder()
+			{
+				finish();
+			}
+
+		public:
+			// Reserves the path for sequences of at most depth_ levels
+			void reserve(size_type depth_)
+			{
+				vPath.reserve(depth_);
+			}
+
+			// Returns the number of open nodes (the deepest depth accepted by push())
+			size_type depth() const
+			{
+				return vPath.size();
+			}
+
+			// Appends a node at depth_ (0 is a child of pParent), closing the open nodes below that depth
+			template <typename... Args_>
+			node_pointer push(size_type depth_, Args_&&... args_)
+			{
+				if (depth_ > vPath.size()) {
+					throw std::invalid_argument("Depth skips a level of the hierarchy.");
+				}
+				close(depth_);
+				auto node_ = create_node(std::forward<Args_>(args_)...);
+				link_impl(get_end(vPath.empty() ? pParent : vPath.back()), node_);
+				vPath.push_back(node_);
+				++nAdded;
+				return node_;
+			}
+
+			// Closes the open nodes until depth_ remain, adding each subtree size to its parent once
+			void close(size_type depth_)
+			{
+				while (vPath.size() > depth_) {
+					auto node_ = vPath.back();
+					vPath.pop_back();
+					if (!vPath.empty()) { (**vPath.back()).nSize += get_size(node_); }
+				}
+			}
+
+			// Closes all open nodes and adds the appended count to pParent and its ancestors
+			void finish()
+			{
+				close(0u);
+				for (node_pointer it_{ pParent }; is_valid(it_); it_ = get_parent(it_)) {
+					(**it_).nSize += nAdded;
+				}
+				nAdded = 0u;
+			}
+		};
+
 		// Interface function to shallow copy node before the position indicated by where_ (exclude sub-tree)
 		static node_pointer shallow_copy(node_pointer where_, const_node_pointer node_)
 		{
@@ -728,6 +2162,12 @@ namespace nsOutTree
 			);
 		}
 
+		// Interface function to compare the counters of two nodes (values are not compared)
+		static bool shape_compare(const_node_pointer first_, const_node_pointer second_)
+		{
+			return shape_compare_impl(first_, second_);
+		}
+
 		// Interface function to deep compare two nodes
 		template <typename TTraversePolicy, typename BinPred_>
 		static bool deep_compare(const_node_pointer first_, const_node_pointer second_, BinPred_&& equal_)
@@ -735,63 +2175,384 @@ namespace nsOutTree
 			return deep_compare_impl(first_, second_, std::forward<BinPred_>(equal_));
 		}
 
-		// Interface function to deep compare range of nodes
-		template <typename TTraversePolicy, typename BinPred_>
-		static bool deep_compare(const_node_pointer lbegin_, const_node_pointer lend_,
-			const_node_pointer rbegin_, const_node_pointer rend_, BinPred_&& equal_)
+		// Interface function to deep compare range of nodes
+		template <typename TTraversePolicy, typename BinPred_>
+		static bool deep_compare(const_node_pointer lbegin_, const_node_pointer lend_,
+			const_node_pointer rbegin_, const_node_pointer rend_, BinPred_&& equal_)
+		{
+			return for_each<TTraversePolicy>(
+				lbegin_, lend_,
+				rbegin_, rend_,
+				[&equal_](auto first_, auto second_) {
+					return deep_compare_impl(first_, second_, std::forward<BinPred_>(equal_));
+				}
+			);
+		}
+
+		// Interface function to deep compare range of nodes on several threads
+		//
+		// All sibling pairs of the range are checked for matching counters before any value is compared.
+		// Pairs whose subtree exceeds the grain are then replaced by their children (comparing the split
+		// node itself on the calling thread), so workers receive subtrees of similar size.
+		// The first mismatch found cancels all other workers. 'equal_' must be safe to call concurrently.
+		template <typename TTraversePolicy, typename BinPred_>
+		static bool parallel_deep_compare(const_node_pointer lbegin_, const_node_pointer lend_,
+			const_node_pointer rbegin_, const_node_pointer rend_, BinPred_&& equal_, size_type thread_count_)
+		{
+			using task_type = std::pair<const_node_pointer, const_node_pointer>;
+
+			std::vector<task_type> tasks_;
+			size_type total_{};
+
+			// Pair up the siblings and reject counter mismatches before comparing any value
+			if (!for_each<TTraversePolicy>(
+				lbegin_, lend_,
+				rbegin_, rend_,
+				[&tasks_, &total_](auto first_, auto second_) {
+					tasks_.emplace_back(first_, second_);
+					total_ += get_size(first_);
+					return shape_compare_impl(first_, second_);
+				}
+			)) { return false; }
+
+			if (thread_count_ == 0) { thread_count_ = std::thread::hardware_concurrency(); }
+
+			// Not worth the threads
+			if (thread_count_ < 2 or total_ < parallel_grain) {
+				for (auto& [first_, second_] : tasks_) {
+					if (!deep_compare_impl(first_, second_, equal_)) { return false; }
+				}
+				return true;
+			}
+
+			// Split subtrees larger than the grain into their children
+			const size_type grain_{ (std::max)(total_ / (thread_count_ * 8), parallel_grain) };
+			for (size_type i_{}; i_ < tasks_.size(); ) {
+				auto [first_, second_] = tasks_[i_];
+				if (get_size(first_) <= grain_) { ++i_; continue; }
+
+				tasks_[i_] = tasks_.back();
+				tasks_.pop_back();
+				if (!for_each<FlatTraversePolicy_>(
+					get_begin(first_), get_end(first_),
+					get_begin(second_), get_end(second_),
+					[&tasks_](auto first_, auto second_) {
+						tasks_.emplace_back(first_, second_);
+						return shape_compare_impl(first_, second_);
+					}
+				)) { return false; }
+				if (!shallow_compare_impl(first_, second_, equal_)) { return false; }
+			}
+
+			std::atomic<bool> cancel_{ false };
+			std::atomic<size_type> next_{ 0 };
+			std::atomic<bool> failed_{ false };
+			std::exception_ptr error_;
+
+			// Claims tasks until they run out or some worker raises the cancellation
+			auto worker_ = [&]() {
+				try {
+					for (size_type i_{}; !cancel_.load(std::memory_order_relaxed)
+						and (i_ = next_.fetch_add(1, std::memory_order_relaxed)) < tasks_.size(); ) {
+						if (!deep_compare_impl(tasks_[i_].first, tasks_[i_].second, equal_, cancel_)) {
+							cancel_.store(true, std::memory_order_relaxed);
+						}
+					}
+				}
+				catch (...) {
+					if (!failed_.exchange(true)) { error_ = std::current_exception(); }
+					cancel_.store(true, std::memory_order_relaxed);
+				}
+			};
+
+			const size_type worker_count_{ (std::min)(thread_count_, static_cast<size_type>(tasks_.size())) };
+			std::vector<std::thread> workers_;
+			workers_.reserve(worker_count_);
+			try {
+				while (workers_.size() + 1 < worker_count_) { workers_.emplace_back(worker_); }
+			}
+			catch (const std::system_error&) {}  // Carry on with the workers started so far
+			worker_();  // The calling thread takes part as well
+			for (auto& thread_ : workers_) { thread_.join(); }
+
+			if (error_) { std::rethrow_exception(error_); }
+			return !cancel_.load();
+		}
+
+		// Interface function to swap_nodes pair of nodes
+		static void swap_nodes(node_pointer first_, node_pointer second_)
+		{
+			if (first_ == second_) { return; }
+			// Special case: Adjacent nodes (A <-> B)
+			if (next_sibling_raw(first_) == second_) {
+				unlink(first_);
+				link(next_sibling_raw(second_), first_);
+				return;
+			}
+			// Handle reverse adjacency
+			if (next_sibling_raw(second_) == first_) {
+				swap_nodes(second_, first_);
+				return;
+			}
+			// General case: Non-adjacent nodes
+			auto first_pos_ = next_sibling_raw(first_);
+			unlink(first_);
+			link(next_sibling_raw(second_), first_);
+			unlink(second_);
+			link(first_pos_, second_);
+		}
+
+		// Interface function to find the first node of the pre-order range [begin, end) matching 'pred_',
+		// entering only the children of nodes approved by 'descend_'
+		template <typename NodeTy_, typename UnPred_, typename DescPred_>
+		static NodeTy_ find_if_pruned(NodeTy_ begin_, NodeTy_ end_, UnPred_&& pred_, DescPred_&& descend_)
+		{
+			return for_each_pruned(
+				begin_, end_, descend_,
+				[&pred_](NodeTy_ node_) { return !pred_(data_ref(const_node_pointer(node_))); }
+			);
+		}
+
+		// Interface function to report up to 'count_' nodes of the pre-order range [begin, end) matching 'pred_',
+		// entering only the children of nodes approved by 'descend_'
+		template <typename NodeTy_, typename UnPred_, typename DescPred_, typename UnOp_>
+		static size_type find_n_pruned(NodeTy_ begin_, NodeTy_ end_, size_type count_,
+			UnPred_&& pred_, DescPred_&& descend_, UnOp_&& report_)
+		{
+			size_type foundCnt_{};
+			if (count_ == 0) { return foundCnt_; }
+			for_each_pruned(
+				begin_, end_, descend_,
+				[&](NodeTy_ node_) {
+					if (pred_(data_ref(const_node_pointer(node_)))) {
+						report_(node_);
+						return (++foundCnt_ < count_);  // Stop after the requested number of hits
+					}
+					return true;
+				}
+			);
+			return foundCnt_;
+		}
+
+		// Interface function to apply op(value) to node, re-filing it in the child index of its parent if its key changed
+		// (also when op throws after modifying the value)
+		template <typename UnOp_>
+		static void modify(node_pointer node_, UnOp_&& op_)
+		{
+			if constexpr (is_keyed) {
+				const auto parent_ = get_parent(node_);
+				if (!(**parent_).pIndex) {
+					op_(data_ref(node_));
+					return;
+				}
+				auto refile_ = [parent_, node_, old_ = key_of(node_)]() {
+					auto new_ = key_of(node_);
+					if (!(new_ == old_)) {
+						index_erase(parent_, old_, node_);
+						(**parent_).pIndex->emplace(std::move(new_), node_);
+					}
+				};
+				try { op_(data_ref(node_)); }
+				catch (...) {
+					refile_();
+					throw;
+				}
+				refile_();
+			}
+			else {
+				op_(data_ref(node_));
+			}
+		}
+
+		// Interface function to rebuild the child index of node (once the keys of its children may have changed)
+		static void reindex([[maybe_unused]] node_pointer node_)
+		{
+			if constexpr (is_keyed) {
+				if (auto index_ = (**node_).pIndex) {
+					index_->clear();
+					for (auto it_{ get_begin(node_) }; it_ != get_end(node_); it_ = next_sibling_raw(it_)) {
+						index_->emplace(key_of(it_), it_);
+					}
+				}
+			}
+		}
+
+		// Interface function to find a child of node by key (or the end sentinel if there is none)
+		// Uses the child index when the node has one, a linear scan of the siblings otherwise
+		static node_pointer find_child(node_pointer node_, const key_type& key_)
+		{
+			static_assert(is_keyed, "find_child() requires traits defining key_of (see KeyedTraits).");
+			if (auto index_ = (**node_).pIndex) {
+				auto found_ = index_->find(key_);
+				return (found_ != index_->end()) ? found_->second : get_end(node_);
+			}
+			for (auto it_{ get_begin(node_) }; it_ != get_end(node_); it_ = next_sibling_raw(it_)) {
+				if (key_of(it_) == key_) { return it_; }
+			}
+			return get_end(node_);
+		}
+
+		// Interface function to sort the children of node (ancestor sizes are unaffected)
+		template <typename Compare_>
+		static void sort_children(node_pointer node_, Compare_&& comp_)
+		{
+			sort_children_impl(node_, comp_);
+		}
+
+		// Interface function to sort the children of node and of all its descendants
+		template <typename Compare_>
+		static void sort_subtree(node_pointer node_, Compare_&& comp_)
+		{
+			// The next pre-order step is taken after sorting, so it descends into the new first child
+			for_each<PreorderTraversePolicy_>(
+				node_, get_end(node_),
+				[&comp_](node_pointer node_) {
+					sort_children_impl(node_, comp_);
+					return true;
+				}
+			);
+		}
+
+		// Interface function to visit the subtrees of the sibling range [first, last) in pre-order,
+		// passing each node with its depth relative to the range (0 for the nodes of the range itself)
+		template <typename NodeTy_, typename BinOp_>
+		static void for_each_depth(NodeTy_ first_, NodeTy_ last_, BinOp_&& op_)
+		{
+			size_type depth_{};
+			for (auto it_ = first_; it_ != last_; ) {
+				op_(it_, depth_);
+				if (has_children(it_)) {
+					it_ = get_begin(it_);
+					++depth_;
+					continue;
+				}
+				// Climb until a node with a following sibling is found (or the range level is reached)
+				while ((depth_ != 0u) and is_sentinel(next_sibling_raw(it_))) {
+					it_ = get_parent(it_);
+					--depth_;
+				}
+				it_ = next_sibling_raw(it_);
+			}
+		}
+
+		// Interface function to visit the subtree of node in pre-order together with the depth of each node
+		template <typename NodeTy_, typename BinOp_>
+		static void for_each_depth(NodeTy_ node_, BinOp_&& op_)
+		{
+			for_each_depth(node_, next_sibling_raw(node_), std::forward<BinOp_>(op_));
+		}
+
+		// Interface function to walk the subtrees of the sibling range [first, last), calling enter(node, depth)
+		// before the descendants of each node and leave(node, depth) after them (depth 0 for the range itself)
+		template <typename NodeTy_, typename Enter_, typename Leave_>
+		static void for_each_event(NodeTy_ first_, NodeTy_ last_, Enter_&& enter_, Leave_&& leave_)
+		{
+			size_type depth_{};
+			for (auto it_ = first_; it_ != last_; ) {
+				enter_(it_, depth_);
+				if (has_children(it_)) {
+					it_ = get_begin(it_);
+					++depth_;
+					continue;
+				}
+				leave_(it_, depth_);
+				// Leave each parent whose last child was just left (up to the range level)
+				while ((depth_ != 0u) and is_sentinel(next_sibling_raw(it_))) {
+					it_ = get_parent(it_);
+					--depth_;
+					leave_(it_, depth_);
+				}
+				it_ = next_sibling_raw(it_);
+			}
+		}
+
+		// Interface function to step 'offset' nodes forward in pre-order (not past end), passing over whole
+		// subtrees by their size: O(depth + siblings passed over)
+		static node_pointer advance_preorder(node_pointer node_, size_type offset_, const_node_pointer end_)
 		{
-			return for_each<TTraversePolicy>(
-				lbegin_, lend_,
-				rbegin_, rend_,
-				[&equal_](auto first_, auto second_) {
-					return deep_compare_impl(first_, second_, std::forward<BinPred_>(equal_));
+			while (offset_ != 0u) {
+				const auto size_ = get_size(node_);
+				if (offset_ < size_) {
+					node_ = get_begin(node_);  // The target lies in this subtree
+					--offset_;
 				}
-			);
+				else {
+					node_ = next_preorder_skip_raw(node_, end_);
+					offset_ -= size_;
+				}
+			}
+			return node_;
 		}
 
-		// Interface function to swap_nodes pair of nodes
-		static void swap_nodes(node_pointer first_, node_pointer second_)
+		// Interface function to apply op(node, position) on the shared pool to the nodes a view of node traverses
+		// (its descendants for pre-order, its children for flat), the position counting from 0 in traversal order;
+		// a grain of 0 selects about 8 tasks per worker
+		template <typename TTraversePolicy, typename NodeTy_, typename UnOp_>
+		static void parallel_for_each(NodeTy_ node_, UnOp_& op_, size_type grain_)
 		{
-			if (first_ == second_) { return; }
-			// Special case: Adjacent nodes (A <-> B)
-			if (next_sibling_raw(first_) == second_) {
-				unlink(first_);
-				link(next_sibling_raw(second_), first_);
-				return;
+			constexpr bool is_flat_{ std::is_same_v<TTraversePolicy, FlatTraversePolicy_> };
+			auto& pool_ = WorkStealingPool::instance();
+			const size_type count_{ is_flat_ ? get_child_count(node_) : get_size(node_) - 1 };
+			if (!grain_) {
+				grain_ = (std::max)(size_type{ 1024 }, count_ / static_cast<size_type>(8 * pool_.concurrency()));
 			}
-			// Handle reverse adjacency
-			if (next_sibling_raw(second_) == first_) {
-				swap_nodes(second_, first_);
-				return;
+
+			WorkStealingPool::Group group_(pool_);
+			if constexpr (is_flat_) {
+				// Runs of 'grain' children, the last one on the calling thread
+				auto first_ = get_begin(node_);
+				size_type index_{};
+				for (auto it_ = first_; it_ != get_end(node_); ) {
+					size_type taken_{};
+					for (; (it_ != get_end(node_)) and (taken_ != grain_); it_ = next_sibling_raw(it_), ++taken_) {}
+					if (it_ == get_end(node_)) { break; }
+					group_.run([first_, it_, index_, &op_]() mutable {
+						for (auto child_ = first_; child_ != it_; child_ = next_sibling_raw(child_)) { op_(child_, index_++); }
+					});
+					first_ = it_;
+					index_ += taken_;
+				}
+				for (; first_ != get_end(node_); first_ = next_sibling_raw(first_)) { op_(first_, index_++); }
 			}
-			// General case: Non-adjacent nodes
-			auto first_pos_ = next_sibling_raw(first_);
-			unlink(first_);
-			link(next_sibling_raw(second_), first_);
-			unlink(second_);
-			link(first_pos_, second_);
+			else {
+				parallel_subtrees(get_begin(node_), get_end(node_), size_type{}, op_, grain_, group_);
+			}
+			group_.wait();
 		}
 
-		// Interface function to formatted output
-		static std::ostream& formatted_stream(std::ostream& os_, const_node_pointer node_)
+	private:
+		// Chunk size of the buffered formatted output
+		static constexpr size_type format_chunk{ size_type{ 1 } << 16 };
+
+		// Helper function to format the subtrees of node into buf, handing the buffer to flush
+		// (which empties it) each time it grows past a chunk and once at the end
+		template <typename Flush_>
+		static void formatted_write(std::string& buf_, Flush_&& flush_, TextFormatter& formatter_, const_node_pointer node_)
 		{
 			if (!has_children(node_)) {
-				os_ << "<empty>\n";
-				return os_;
+				formatter_.append_text(buf_, "<empty>\n");
+				flush_(buf_);
+				return;
 			}
+			std::string indent_;  // Cached indentation, grown to the deepest level met so far
 			size_type depth_{};
 
 			for (auto it_{ get_begin(node_) }, end_{ get_end(node_) }; it_ != end_; ) {
 				// Print indentation and node
 				if (depth_ > 0) {
-					for (size_type i{}; i + 1 < depth_; ++i) { os_ << "        "; }
-					os_ << "|------ ";
+					const auto width_ = (depth_ - 1) * 8;
+					if (indent_.size() < width_) { indent_.resize((std::max)(width_, 2 * indent_.size()), ' '); }
+					buf_.append(indent_, 0, width_);
+					buf_ += "|------ ";
 				}
 #ifdef _DEBUG
-				os_ << "[" << depth_ << "] ";
+				formatter_.append_text(buf_, "[");
+				formatter_.append(buf_, depth_);
+				buf_ += "] ";
 #endif // _DEBUG
-				print_node_value(os_, data_ref(it_));
-				os_ << "\n";
+				formatter_.append(buf_, data_ref(it_));
+				buf_ += '\n';
+				if (buf_.size() >= format_chunk) { flush_(buf_); }
 
 				// Move to the next node in preorder and adjust depth
 				if (has_children(it_)) {
@@ -809,11 +2570,56 @@ namespace nsOutTree
 				}
 			}
 #ifdef _DEBUG
-			os_ << "Size: " << get_size(node_) << "\n";
+			buf_ += "Size: ";
+			formatter_.append(buf_, get_size(node_));
+			buf_ += '\n';
 #endif // _DEBUG
+			flush_(buf_);
+		}
+
+
+	public:
+		// Interface function to formatted output (buffered, written in chunks through os.write())
+		static std::ostream& formatted_stream(std::ostream& os_, const_node_pointer node_)
+		{
+			TextFormatter formatter_(os_);
+			std::string buf_;
+			buf_.reserve(format_chunk + 256);
+			formatted_write(buf_, [&os_](std::string& text_) { os_.write(text_.data(), text_.size()); text_.clear(); }, formatter_, node_);
+			os_.width(0);
 			return os_;
 		}
 
+		// Interface function to formatted output into a string (same text as formatted_stream())
+		static std::string formatted_string(const_node_pointer node_)
+		{
+			TextFormatter formatter_;
+			std::string buf_;
+			// Pre-size for the exact indentation and newlines plus a short guess per value
+			size_type bytes_{};
+			if (has_children(node_)) {
+				for_each_depth(get_begin(node_), get_end(node_),
+					[&bytes_](const_node_pointer, size_type depth_) { bytes_ += depth_ * 8 + 8; });
+			}
+			buf_.reserve(bytes_);
+			formatted_write(buf_, [](std::string&) {}, formatter_, node_);
+			return buf_;
+		}
+
+		// Interface function to formatted output into a sink called as sink(const char* data, size_type count)
+		// with chunks of about 64 KiB (same text as formatted_stream())
+		template <typename Sink_>
+		static void formatted_sink(Sink_&& sink_, const_node_pointer node_)
+		{
+			TextFormatter formatter_;
+			std::string buf_;
+			buf_.reserve(format_chunk + 256);
+			formatted_write(buf_, [&sink_](std::string& text_) {
+					if (!text_.empty()) { sink_(static_cast<const char*>(text_.data()), static_cast<size_type>(text_.size())); }
+					text_.clear();
+				}, formatter_, node_);
+		}
+
 
 	public:
 		// Helper function to access the parent const pointer
@@ -906,10 +2712,12 @@ namespace nsOutTree
 		}
 
 		// Helper function to access the first child const pointer (or end sentinel if no children)
+		// The first-child link is read once (it points back to the node itself when there are no children)
 		static const_node_pointer get_begin(const_node_pointer node_)
 		{
-			return has_children(node_)
-				? &(**node_).pREnd->pSelf
+			const node_type* first_ = (**node_).pREnd;
+			return (first_ != &**node_)
+				? &first_->pSelf
 				: &(**node_).pEnd;
 		}
 
@@ -938,10 +2746,12 @@ namespace nsOutTree
 		}
 
 		// Helper function to access the last child const pointer (or rend sentinel if no children)
+		// The last-child link is read once (it points back to the node itself when there are no children)
 		static const_node_pointer get_rbegin(const_node_pointer node_)
 		{
-			return has_children(node_)
-				? &(**node_).pEnd->pSelf
+			const node_type* last_ = (**node_).pEnd;
+			return (last_ != &**node_)
+				? &last_->pSelf
 				: &(**node_).pREnd;
 		}
 
@@ -1178,6 +2988,31 @@ namespace nsOutTree
 			return condition_ and (node_ == end_);
 		}
 
+		// @brief  Traverses range of nodes in pre-order, entering only the subtrees approved by a predicate.
+		//
+		// @tparam NodeTy_  The type of the node pointer (e.g., node_pointer, const_node_pointer).
+		// @tparam UnPred_  A callable object that takes (value) and returns whether the children of that node are visited.
+		// @tparam UnOp_  A callable object (functor or lambda) that takes (node) and returns a boolean
+		//         indicating whether traversal should continue (true) or halt (false).
+		//
+		// @param node_  The starting node pointer of the traversal range (inclusive).
+		// @param end_  The end sentinel of the subtree enclosing the range (exclusive).
+		// @param descend_  An instance of the UnPred_ functor, called only for nodes having children.
+		// @param op_  An instance of the UnOp_ functor to be applied to each visited node.
+		//
+		// @return  The node on which the operation returned false, or 'end_' if the traversal completed.
+		// @note  A rejected subtree is passed over in a single step, without visiting its nodes.
+		template<typename NodeTy_, typename UnPred_, typename UnOp_>
+		static NodeTy_ for_each_pruned(NodeTy_ node_, NodeTy_ end_, UnPred_&& descend_, UnOp_&& op_)
+		{
+			while (node_ != end_ and op_(node_)) {
+				node_ = (has_children(node_) and descend_(data_ref(const_node_pointer(node_))))
+					? next_preorder_raw(node_, end_)
+					: next_preorder_skip_raw(node_, end_);
+			}
+			return node_;
+		}
+
 		// @brief  Traverses two ranges of nodes in parallel (lockstep), applying a binary operation to corresponding nodes.
 		//
 		// @tparam TTraversePolicy  A callable object (functor or lambda) that takes (current_node, end_node)
@@ -1304,6 +3139,7 @@ namespace nsOutTree
 	public:
 		// Standard type aliases
 		using self_type        = Container;
+		using traits_type      = TTraits;
 		using value_type       = typename TTraits::value_type;
 		using pointer          = typename TTraits::pointer;
 		using const_pointer    = typename TTraits::const_pointer;
@@ -1312,6 +3148,12 @@ namespace nsOutTree
 		using difference_type  = typename TTraits::difference_type;
 		using size_type        = typename TTraits::size_type;
 
+	private:
+		// Friend declarations (transform() builds containers of other value types)
+		template <typename, typename> friend class Container;
+		template <typename> friend class ConcurrentContainer;
+		template <typename> friend class LockedContainer;
+
 	private:
 		// Node management type aliases
 		using Node                = typename NodeManager<self_type>;
@@ -1319,6 +3161,7 @@ namespace nsOutTree
 		using node_base           = typename Node::node_base;
 		using node_pointer        = typename Node::node_pointer;
 		using const_node_pointer  = typename Node::const_node_pointer;
+		using node_link           = typename Node::node_link;
 
 		// Generic iterator types
 		template <bool B, typename U> using generic_iterator  = Iterator<self_type, B, U>;
@@ -1342,8 +3185,184 @@ namespace nsOutTree
 		using const_reverse_preorder_iterator  = std::reverse_iterator<const_preorder_iterator>;
 		using reverse_preorder_iterator        = std::reverse_iterator<preorder_iterator>;
 
+		// Key type of the keyed child lookup (a placeholder unless the traits define key_of)
+		using key_type  = typename Node::key_type;
+		// Whether the traits define key_of; iterators then give read-only access and values change through modify()
+		static constexpr bool is_keyed{ Node::is_keyed };
+		// Parent entry marking a top-level node in build_from_parents (any negative entry does as well)
+		static constexpr size_type npos{ static_cast<size_type>(-1) };
+
 
 	public:
+		//=== Containers made by shard(), with the moves merge_shards() undoes to restore the original forest ===//
+		//   Values may be changed and nodes added or removed in the shards, except the moved subtree roots,
+		//   which must stay (and stay where they were put) until the shards are merged.
+		class Shards
+		{
+		private:
+			// Friend declarations
+			friend class Container;
+
+		private:
+			std::vector<self_type> vShards;
+			std::vector<std::pair<node_pointer, node_pointer>> vMoves;  // Moved node and its next sibling before the move
+
+		public:
+			// Default constructor: no shards
+			Shards() = default;
+			// Move constructor
+			Shards(Shards&&) noexcept = default;
+			// Move assignment operator
+			Shards& operator =(Shards&&) noexcept = default;
+			// Deleted constructors and operators (the moves refer to the nodes of these very shards)
+			Shards(const Shards&) = delete;
+			Shards& operator =(const Shards&) = delete;
+
+		public:
+			// Returns the number of shards
+			size_type size() const
+			{
+				return static_cast<size_type>(vShards.size());
+			}
+			// Returns shard number 'index_'
+			self_type& operator [](size_type index_)
+			{
+				return vShards[index_];
+			}
+			const self_type& operator [](size_type index_) const
+			{
+				return vShards[index_];
+			}
+			// Iterators over the shards
+			auto begin()
+			{
+				return vShards.begin();
+			}
+			auto end()
+			{
+				return vShards.end();
+			}
+			auto begin() const
+			{
+				return vShards.begin();
+			}
+			auto end() const
+			{
+				return vShards.end();
+			}
+		};
+
+		//=== Range of a view that divides into two halves of about the same node count (for parallel algorithms) ===//
+		//   A pre-order range counts every node and splits at the one halfway through, found by passing over whole
+		//   subtrees by their size; a flat range counts the children and walks to the middle one.
+		//   Ranges of a const view (Const) and their parts only hand out const iterators.
+		template <typename TTraversePolicy, bool Const>
+		class SplitView
+		{
+		public:
+			// Standard type aliases
+			using self_type        = SplitView;
+			using const_self_type  = SplitView<TTraversePolicy, true>;
+
+			// Iterators over the range
+			using const_policy_iterator  = Iterator<Container, true, TTraversePolicy>;
+			using policy_iterator        = Iterator<Container, Const, TTraversePolicy>;
+
+			// Friend declarations
+			template <typename, bool> friend class SplitView;
+
+		private:
+			static constexpr bool is_flat{ std::is_same_v<TTraversePolicy, FlatTraversePolicy> };
+
+		private:
+			node_pointer pView;   // The node whose view contains the range
+			node_pointer pBegin;  // The first node of the range
+			node_pointer pEnd;    // The node past the range (the end sentinel of the view for the last part)
+			size_type nCount;     // The number of nodes of the range
+
+		public:
+			// Constructor: the whole view of a node (raw pointer)
+			explicit SplitView(node_pointer node_)
+				: pView{ node_ }, pBegin{ Node::get_begin(node_) }, pEnd{ Node::get_end(node_) },
+				nCount{ is_flat ? Node::get_child_count(node_) : Node::get_size(node_) - 1 }
+			{
+				Node::validate_source(node_);
+			}
+
+		private:
+			// Constructor of a part
+			SplitView(node_pointer view_, node_pointer begin_, node_pointer end_, size_type count_)
+				: pView{ view_ }, pBegin{ begin_ }, pEnd{ end_ }, nCount{ count_ } {}
+
+		public:
+			// Returns a constant iterator to the first node of the range
+			const_policy_iterator begin() const
+			{
+				return const_policy_iterator(pBegin, pView);
+			}
+			// Returns a constant iterator past the last node of the range
+			const_policy_iterator end() const
+			{
+				return const_policy_iterator(pEnd, pView);
+			}
+			// Returns an iterator to the first node of the range
+			policy_iterator begin()
+			{
+				return policy_iterator(pBegin, pView);
+			}
+			// Returns an iterator past the last node of the range
+			policy_iterator end()
+			{
+				return policy_iterator(pEnd, pView);
+			}
+
+			// Returns the number of nodes of the range
+			size_type size() const
+			{
+				return nCount;
+			}
+			// Checks if the range is empty
+			bool empty() const
+			{
+				return !nCount;
+			}
+			// Checks if the range holds more than 'grain_' nodes
+			bool is_divisible(size_type grain_ = 1) const
+			{
+				return nCount > grain_;
+			}
+
+			// @brief  Divides the range into [begin, middle) of size()/2 nodes and [middle, end) of the others.
+			//
+			// @return  Both parts (read-only ones for a const range); the range itself is unchanged.
+			// @note  O(depth + siblings passed over) for pre-order, O(size()/2) for flat ranges.
+			std::pair<const_self_type, const_self_type> split() const
+			{
+				return split_impl<const_self_type>();
+			}
+			// @brief  Divides the range into [begin, middle) of size()/2 nodes and [middle, end) of the others.
+			std::pair<self_type, self_type> split()
+			{
+				return split_impl<self_type>();
+			}
+
+		private:
+			// Finds the middle node and builds both parts
+			template <typename Part_>
+			std::pair<Part_, Part_> split_impl() const
+			{
+				const size_type half_{ nCount / 2 };
+				auto middle_ = pBegin;
+				if constexpr (is_flat) {
+					for (size_type i_{}; i_ != half_; ++i_) { middle_ = FlatTraversePolicy::policy_next(middle_); }
+				}
+				else {
+					middle_ = Node::advance_preorder(pBegin, half_, Node::get_end(pView));
+				}
+				return { Part_(pView, pBegin, middle_, half_), Part_(pView, middle_, pEnd, nCount - half_) };
+			}
+		};
+
 		//=== Defines the common interface for providing sub-tree methods ===//
 		template <typename TTraversePolicy>
 		class PolicyView
@@ -1468,6 +3487,79 @@ namespace nsOutTree
 				);
 			}
 
+			// @brief  Applies an operation to every element of the view on the shared WorkStealingPool.
+			//
+			// @param op_  A unary operation taking an element; it is called concurrently, in no particular order.
+			// @param grain_  The node count of one task: larger subtrees are split, smaller neighbours batched
+			//                (0 selects about 8 tasks per worker, of at least 1024 nodes).
+			// @throws  The first exception thrown by `op_`, once the running tasks have finished (the others are skipped).
+			template <typename UnOp_>
+			void parallel_for_each(UnOp_&& op_, size_type grain_ = 0) const
+			{
+				auto visit_ = [&op_](const_node_pointer node_, size_type) { op_(Node::data_ref(node_)); };
+				Node::template parallel_for_each<TTraversePolicy>(const_node_pointer(pNode), visit_, grain_);
+			}
+			// @brief  Applies an operation to every element of the view on the shared WorkStealingPool.
+			template <typename UnOp_>
+			void parallel_for_each(UnOp_&& op_, size_type grain_ = 0)
+			{
+				if constexpr (is_keyed) {  // Keys must not change behind the child index
+					static_cast<const self_type*>(this)->parallel_for_each(std::forward<UnOp_>(op_), grain_);
+				}
+				else {
+					auto visit_ = [&op_](node_pointer node_, size_type) { op_(Node::data_ref(node_)); };
+					Node::template parallel_for_each<TTraversePolicy>(pNode, visit_, grain_);
+				}
+			}
+
+			// @brief  Removes the elements of the view that satisfy a predicate, evaluated on the shared WorkStealingPool.
+			//
+			// @param pr_  The unary predicate; it is called concurrently, once per element, in no particular order.
+			// @param grain_  The node count of one task (see parallel_for_each()).
+			// @return  The number of elements removed (matching nodes with their subtrees).
+			// @throws  The first exception thrown by `pr_`; nothing is removed then.
+			// @note  The matches are unlinked afterwards in one serial pass, as remove_if() does.
+			template <typename UnPred_>
+			size_type parallel_remove_if(UnPred_&& pr_, size_type grain_ = 0)
+			{
+				return Node::template parallel_remove_if<TTraversePolicy>(pNode, pr_, grain_);
+			}
+
+			// @brief  Applies 'op_' to every element of the view in place, on the shared WorkStealingPool.
+			//
+			// @param op_  A unary operation whose result is assigned back to the element, or which modifies its
+			//             (non-const) argument and returns void; it is called concurrently, in no particular order.
+			// @param grain_  The node count of one task (see parallel_for_each()).
+			template <typename UnOp_>
+			void parallel_transform_values(UnOp_&& op_, size_type grain_ = 0)
+			{
+				auto visit_ = [&op_](node_pointer node_, size_type) { transform_value(Node::data_ref(node_), op_); };
+				if constexpr (is_keyed) {
+					try { Node::template parallel_for_each<TTraversePolicy>(pNode, visit_, grain_); }
+					catch (...) {
+						reindex(grain_);
+						throw;
+					}
+					reindex(grain_);
+				}
+				else {
+					Node::template parallel_for_each<TTraversePolicy>(pNode, visit_, grain_);
+				}
+			}
+
+		private:
+			// Rebuilds the child indexes the keys of the view belong to (each node's own index in a separate task)
+			void reindex(size_type grain_)
+			{
+				if constexpr (std::is_same_v<TTraversePolicy, PreorderTraversePolicy>) {
+					auto visit_ = [](node_pointer node_, size_type) { Node::reindex(node_); };
+					Node::template parallel_for_each<TTraversePolicy>(pNode, visit_, grain_);
+				}
+				Node::reindex(pNode);
+			}
+
+		public:
+
 			// @brief  Creates shallow copies of a range of nodes [begin, end) and inserts them into the container.
 			//
 			// @param where_  An iterator indicating the position before which the copied range will be inserted.
@@ -1484,6 +3576,98 @@ namespace nsOutTree
 			}
 
 		public:
+			// @brief  Finds the first node in pre-order satisfying 'pred_', skipping the subtrees rejected by 'descend_'.
+			//
+			// @tparam UnPred_  A unary predicate type taking an element and returning whether it matches.
+			// @tparam DescPred_  A unary predicate type taking an element and returning whether its children are searched.
+			// @param pred_  The unary predicate selecting the node to be found.
+			// @param descend_  The unary predicate deciding whether to enter the children of a node.
+			// @return  A `const_policy_iterator` to the found node, or `end()` if no node matches.
+			// @note  A rejected subtree is jumped over without visiting its nodes (available for pre-order views only).
+			template <typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, const_policy_iterator>
+				find_if(UnPred_&& pred_, DescPred_&& descend_) const
+			{
+				return const_policy_iterator(
+					Node::find_if_pruned(Node::get_begin(pNode), Node::get_end(pNode), pred_, descend_),
+					pNode
+				);
+			}
+			// @brief  Finds the first node in pre-order satisfying 'pred_', skipping the subtrees rejected by 'descend_'.
+			template <typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, policy_iterator>
+				find_if(UnPred_&& pred_, DescPred_&& descend_)
+			{
+				return policy_iterator(
+					static_cast<const self_type*>(this)->find_if(pred_, descend_)
+				);
+			}
+
+			// @brief  Writes an iterator to every node satisfying 'pred_' to 'out_', skipping the subtrees rejected by 'descend_'.
+			//
+			// @param out_  An output iterator receiving `const_policy_iterator`s to the matching nodes, in pre-order.
+			// @param pred_  The unary predicate selecting the nodes to be found.
+			// @param descend_  The unary predicate deciding whether to enter the children of a node.
+			// @return  The output iterator past the last written element.
+			template <typename OutputIt_, typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, OutputIt_>
+				find_all(OutputIt_ out_, UnPred_&& pred_, DescPred_&& descend_) const
+			{
+				return find_n_impl<const_policy_iterator>(out_, (std::numeric_limits<size_type>::max)(), pred_, descend_);
+			}
+			// @brief  Writes an iterator to every node satisfying 'pred_' to 'out_', skipping the subtrees rejected by 'descend_'.
+			template <typename OutputIt_, typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, OutputIt_>
+				find_all(OutputIt_ out_, UnPred_&& pred_, DescPred_&& descend_)
+			{
+				return find_n_impl<policy_iterator>(out_, (std::numeric_limits<size_type>::max)(), pred_, descend_);
+			}
+
+			// @brief  Same as find_all(), but stops the search after 'count_' matches.
+			//
+			// @param out_  An output iterator receiving `const_policy_iterator`s to the matching nodes, in pre-order.
+			// @param count_  The maximum number of matches to be written.
+			// @param pred_  The unary predicate selecting the nodes to be found.
+			// @param descend_  The unary predicate deciding whether to enter the children of a node.
+			// @return  The output iterator past the last written element.
+			template <typename OutputIt_, typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, OutputIt_>
+				find_n(OutputIt_ out_, size_type count_, UnPred_&& pred_, DescPred_&& descend_) const
+			{
+				return find_n_impl<const_policy_iterator>(out_, count_, pred_, descend_);
+			}
+			// @brief  Same as find_all(), but stops the search after 'count_' matches.
+			template <typename OutputIt_, typename UnPred_, typename DescPred_, typename U = TTraversePolicy>
+			std::enable_if_t<std::is_same_v<U, PreorderTraversePolicy>, OutputIt_>
+				find_n(OutputIt_ out_, size_type count_, UnPred_&& pred_, DescPred_&& descend_)
+			{
+				return find_n_impl<policy_iterator>(out_, count_, pred_, descend_);
+			}
+
+		private:
+			// Shared implementation of find_all() and find_n(), writing iterators of type It_
+			template <typename It_, typename OutputIt_, typename UnPred_, typename DescPred_>
+			OutputIt_ find_n_impl(OutputIt_ out_, size_type count_, UnPred_& pred_, DescPred_& descend_) const
+			{
+				Node::find_n_pruned(
+					Node::get_begin(pNode), Node::get_end(pNode), count_, pred_, descend_,
+					[this, &out_](node_pointer node_) { *out_++ = It_(node_, pNode); }
+				);
+				return out_;
+			}
+
+		public:
+			// Returns the view as a read-only range that splits into halves of about the same node count
+			SplitView<TTraversePolicy, true> split_view() const
+			{
+				return SplitView<TTraversePolicy, true>(pNode);
+			}
+			// Returns the view as a range that splits into halves of about the same node count
+			SplitView<TTraversePolicy, false> split_view()
+			{
+				return SplitView<TTraversePolicy, false>(pNode);
+			}
+
 			// Returns the number of direct children of the node
 			size_type child_count() const
 			{
@@ -1516,8 +3700,9 @@ namespace nsOutTree
 
 
 	private:
-		node_pointer pRoot{
-			Node::self( new node_base{} )
+		// Root sentinel (stored as a link, so that the container may live in a relocatable arena)
+		node_link pRoot{
+			Node::create_root()
 		};
 
 
@@ -1608,7 +3793,7 @@ namespace nsOutTree
 		~Container()
 		{
 			clear();
-			delete static_cast<node_base*>(*pRoot);
+			Node::destroy_root(pRoot);
 		}
 
 		// Default constructor
@@ -1646,13 +3831,13 @@ namespace nsOutTree
 		// Constructor taking a const_reference value
 		explicit Container(const_reference value_) 
 		{
-			Node::link(Node::get_end(pRoot), Node::self(new node_type(value_)));
+			Node::link(Node::get_end(pRoot), Node::create_node(value_));
 		}
 
 		// Constructor taking an rvalue_type value
 		explicit Container(value_type&& value_) noexcept
 		{
-			Node::link(Node::get_end(pRoot), Node::self(new node_type(std::move(value_))));
+			Node::link(Node::get_end(pRoot), Node::create_node(std::move(value_)));
 		}
 
 		// Constructor from an initializer list
@@ -1684,21 +3869,179 @@ namespace nsOutTree
 			return *this;
 		}
 
-		// Assignment operator from an initializer list
-		self_type& operator =(std::initializer_list<value_type> init_)
-		{
-			clear();
-			for (auto it = std::begin(init_); it != std::end(init_); ++it) {
-				Node::link(Node::get_end(pRoot), Node::self(new node_type(*it)));
+		// Assignment operator from an initializer list
+		self_type& operator =(std::initializer_list<value_type> init_)
+		{
+			clear();
+			for (auto it = std::begin(init_); it != std::end(init_); ++it) {
+				Node::link(Node::get_end(pRoot), Node::create_node(*it));
+			}
+			return *this;
+		}
+
+		// @brief  Builds a forest from a pre-order sequence of {depth, value} pairs in one linear pass.
+		//
+		// @param first_  An input iterator to the first pair-like element.
+		// @param last_  An input iterator past the last element.
+		// @return  The constructed container. Depth 0 denotes a top-level node.
+		// @throws  std::invalid_argument If an element is more than one level deeper than its predecessor.
+		template <typename InputIt_>
+		static self_type build_from_preorder(InputIt_ first_, InputIt_ last_)
+		{
+			self_type cont_;
+			typename Node::PreorderBuilder builder_(cont_.pRoot);
+			for (; first_ != last_; ++first_) {
+				auto&& [depth_, value_] = *first_;
+				builder_.push(static_cast<size_type>(depth_), value_);
+			}
+			builder_.finish();
+			return cont_;
+		}
+		// @brief  Same as above, taking the whole range of {depth, value} pairs.
+		template <typename Range_>
+		static self_type build_from_preorder(const Range_& range_)
+		{
+			return build_from_preorder(std::begin(range_), std::end(range_));
+		}
+
+		// @brief  Builds a forest from values and the index of each value's parent in one linear pass.
+		//
+		// @param values_  A random access range of values.
+		// @param parents_  A random access range of the same length holding the index of each parent.
+		//                  A top-level node is marked by a negative entry or, for unsigned entries, by the
+		//                  all-ones value of the entry type (npos). Siblings keep their index order.
+		// @return  The constructed container.
+		// @throws  std::invalid_argument If the lengths differ, an index is out of range or the parents form a cycle.
+		template <typename ValueRange_, typename ParentRange_>
+		static self_type build_from_parents(const ValueRange_& values_, const ParentRange_& parents_)
+		{
+			const auto valueIt_ = std::begin(values_);
+			const auto parentIt_ = std::begin(parents_);
+			const auto count_ = static_cast<size_type>(std::distance(valueIt_, std::end(values_)));
+			if (static_cast<size_type>(std::distance(parentIt_, std::end(parents_))) != count_) {
+				throw std::invalid_argument("Value and parent ranges differ in length.");
+			}
+
+			// Slot of the parent entry; slot 'count_' collects top-level nodes
+			const auto slot_of_ = [count_](const auto parent_) -> size_type {
+				using parent_type_ = std::decay_t<decltype(parent_)>;
+				if constexpr (std::is_signed_v<parent_type_>) {
+					if (parent_ < 0) { return count_; }
+				}
+				else {
+					if (parent_ == static_cast<parent_type_>(-1)) { return count_; }
+				}
+				if (static_cast<size_type>(parent_) >= count_) {
+					throw std::invalid_argument("Parent index out of range.");
+				}
+				return static_cast<size_type>(parent_);
+			};
+
+			// Group children by parent, keeping index order
+			std::vector<size_type> offsets_(count_ + 2u);
+			for (size_type i_{}; i_ != count_; ++i_) {
+				++offsets_[slot_of_(parentIt_[i_]) + 1u];
+			}
+			for (size_type i_{ 1 }; i_ != offsets_.size(); ++i_) { offsets_[i_] += offsets_[i_ - 1u]; }
+			std::vector<size_type> children_(count_);
+			{
+				std::vector<size_type> fill_(offsets_.begin(), offsets_.end() - 1);
+				for (size_type i_{}; i_ != count_; ++i_) {
+					children_[fill_[slot_of_(parentIt_[i_])]++] = i_;
+				}
+			}
+
+			// Lay out the pre-order before allocating anything; nodes not reached belong to a cycle
+			std::vector<std::pair<size_type, size_type>> order_;  // {depth, index}
+			order_.reserve(count_);
+			std::vector<std::pair<size_type, size_type>> stack_{ { count_, offsets_[count_] } };  // {slot, next child}
+			while (!stack_.empty()) {
+				auto& [slot_, next_] = stack_.back();
+				if (next_ == offsets_[slot_ + 1u]) { stack_.pop_back(); continue; }
+				const auto child_ = children_[next_++];
+				order_.emplace_back(stack_.size() - 1u, child_);
+				stack_.emplace_back(child_, offsets_[child_]);
+			}
+			if (order_.size() != count_) {
+				throw std::invalid_argument("Parent indices form a cycle.");
+			}
+
+			self_type cont_;
+			typename Node::PreorderBuilder builder_(cont_.pRoot);
+			for (const auto& [depth_, index_] : order_) {
+				builder_.push(depth_, valueIt_[index_]);
+			}
+			builder_.finish();
+			return cont_;
+		}
+
+		//=== Builds a container from a stream of begin_node(value) / end_node() events ===//
+		//   Nodes are linked in arrival order and each subtree size is added to its parent once,
+		//   when the subtree is closed; nodes come from Node::create_node (the traits' allocator, if any).
+		class EventBuilder
+		{
+		private:
+			self_type cResult;
+			std::optional<typename Node::PreorderBuilder> oBuilder;
+			size_type nOpen{};  // Nodes begun and not yet ended
+
+		public:
+			// Default constructor: starts an empty container
+			EventBuilder()
+			{
+				oBuilder.emplace(cResult.pRoot);
+			}
+			// Deleted constructors and operators
+			EventBuilder(const EventBuilder&) = delete;
+			EventBuilder& operator =(const EventBuilder&) = delete;
+
+		public:
+			// Begins a node (constructed from args_) as the next child of the innermost open node
+			template <typename... Args_>
+			void begin_node(Args_&&... args_)
+			{
+				if (!oBuilder) {
+					throw std::logic_error("The builder has already finished.");
+				}
+				oBuilder->push(nOpen, std::forward<Args_>(args_)...);
+				++nOpen;
+			}
+
+			// Ends the innermost open node
+			void end_node()
+			{
+				if (nOpen == 0) {
+					throw std::logic_error("No open node to end.");
+				}
+				--nOpen;
 			}
-			return *this;
-		}
+
+			// Returns the number of open nodes
+			size_type depth() const
+			{
+				return nOpen;
+			}
+
+			// Returns the built container (all nodes must have been ended)
+			self_type finish()
+			{
+				if (nOpen != 0) {
+					throw std::logic_error("Nodes are still open.");
+				}
+				if (!oBuilder) {
+					throw std::logic_error("The builder has already finished.");
+				}
+				oBuilder.reset();  // Accounts for the subtree sizes
+				return std::move(cResult);
+			}
+		};
 
 
 		// Equality operator for containers
 		friend bool operator ==(const self_type& lhs_, const self_type& rhs_)
 		{
 			if (&lhs_ == &rhs_) { return true; }
+			if (!Node::shape_compare(lhs_.pRoot, rhs_.pRoot)) { return false; }  // Size or top-level count mismatch
 			return Node::template deep_compare<FlatTraversePolicy>(
 				Node::get_begin(lhs_.pRoot), Node::get_end(lhs_.pRoot),
 				Node::get_begin(rhs_.pRoot), Node::get_end(rhs_.pRoot),
@@ -1706,6 +4049,19 @@ namespace nsOutTree
 			);
 		}
 
+		// Equality check for containers, comparing large forests on several threads
+		// (thread_count_ == 0 selects std::thread::hardware_concurrency())
+		friend bool parallel_equal(const self_type& lhs_, const self_type& rhs_, size_type thread_count_ = 0)
+		{
+			if (&lhs_ == &rhs_) { return true; }
+			if (!Node::shape_compare(lhs_.pRoot, rhs_.pRoot)) { return false; }  // Size or top-level count mismatch
+			return Node::template parallel_deep_compare<FlatTraversePolicy>(
+				Node::get_begin(lhs_.pRoot), Node::get_end(lhs_.pRoot),
+				Node::get_begin(rhs_.pRoot), Node::get_end(rhs_.pRoot),
+				std::equal_to<>(), thread_count_
+			);
+		}
+
 		// Inequality operator for containers
 		friend bool operator !=(const self_type& lhs_, const self_type& rhs_)
 		{
@@ -1722,24 +4078,73 @@ namespace nsOutTree
 	public:
 		// @brief  Appends one or more trees as children of the last node in a pre-order traversal.
 		//
-		// @tparam Trees  Variadic pack of rvalue references to tree types (self_type&&).
-		// @param trees_  One or more tree objects to append. These are moved into the container.
+		// @tparam Trees  Variadic pack of rvalue references to tree types (self_type&&) or node expressions.
+		// @param trees_  One or more tree objects to append. These are moved into the container;
+		//                node expressions (see nsOutTree::node()) are built in place instead.
 		// @return  A reference to the current tree (*this) for method chaining.
 		// @note  The insertion point is the end of the node preceding the end sentinel in a pre-order
 		//        traversal, effectively adding children to the deepest, rightmost node.
 		template<typename... Trees>
 		self_type& append(Trees&&... trees_)
 		{
-			auto where_ = empty()  // As child of last in pre-order node
-				? Node::get_end(pRoot)
-				: Node::get_end(PreorderTraversePolicy::policy_prev(Node::get_end(pRoot)));
+			auto parent_ = empty()  // As child of last in pre-order node
+				? pRoot
+				: PreorderTraversePolicy::policy_prev(Node::get_end(pRoot));
+			auto where_ = Node::get_end(parent_);
+			typename Node::PreorderBuilder builder_(parent_);
+			builder_.reserve(expression_depth<Trees...>());
 
 			([&](auto&& other_) {
-				Node::template move<FlatTraversePolicy>(where_, Node::get_begin(other_.pRoot), Node::get_end(other_.pRoot));
+				if constexpr (is_node_expression_v<decltype(other_)>) {
+					build_expression(builder_, 0u, std::forward<decltype(other_)>(other_));
+				}
+				else {
+					Node::template move<FlatTraversePolicy>(where_, Node::get_begin(other_.pRoot), Node::get_end(other_.pRoot));
+				}
 				}(std::forward<Trees>(trees_)), ...);
+			builder_.finish();
 			return *this;
 		}
 
+		// @brief  Builds a forest from node expressions, allocating exactly one node per value.
+		//
+		// @param exprs_  Top-level node expressions, e.g. make(node(1, node(11, node(111)), node(12)), node(2)).
+		// @return  The constructed container.
+		template <typename... Exprs>
+		static self_type make(Exprs&&... exprs_)
+		{
+			static_assert((is_node_expression_v<Exprs> and ...), "Arguments must be node expressions.");
+			self_type cont_;
+			typename Node::PreorderBuilder builder_(cont_.pRoot);
+			builder_.reserve(expression_depth<Exprs...>());
+			(build_expression(builder_, 0u, std::forward<Exprs>(exprs_)), ...);
+			builder_.finish();
+			return cont_;
+		}
+
+	private:
+		// Returns the number of levels of the deepest node expression in Args (0 without any)
+		template <typename... Args>
+		static constexpr size_type expression_depth()
+		{
+			return static_cast<size_type>((std::max)({ std::size_t{ 0 }, is_node_expression<std::decay_t<Args>>::depth... }));
+		}
+
+		// Appends the nodes of an expression at depth_ of the builder (values are moved out of rvalues)
+		template <typename Expr_>
+		static void build_expression(typename Node::PreorderBuilder& builder_, size_type depth_, Expr_&& expr_)
+		{
+			builder_.push(depth_, std::forward<Expr_>(expr_).value);
+			std::apply(
+				[&builder_, depth_](auto&&... children_) {
+					(build_expression(builder_, depth_ + 1u, std::forward<decltype(children_)>(children_)), ...);
+				},
+				std::forward<Expr_>(expr_).children
+			);
+		}
+
+	public:
+
 		// @brief  Inserts a single value by copy before the position indicated by 'where_'.
 		//
 		// @param where_  An iterator indicating the position before which the new node will be inserted.
@@ -1751,7 +4156,7 @@ namespace nsOutTree
 		{
 			validate_destination(where_);
 			return iterator<U>(
-				Node::link(where_.base(), Node::self(new node_type(value_)))
+				Node::link(where_.base(), Node::create_node(value_))
 			);
 		}
 
@@ -1766,7 +4171,7 @@ namespace nsOutTree
 		{
 			validate_destination(where_);
 			return iterator<U>(
-				Node::link(where_.base(), Node::self(new node_type(std::move(value_))))  // Uses move semantics
+				Node::link(where_.base(), Node::create_node(std::move(value_)))  // Uses move semantics
 			);
 		}
 
@@ -1781,7 +4186,7 @@ namespace nsOutTree
 		{
 			validate_destination(where_);
 			for (auto it = std::rbegin(init_); it != std::rend(init_); ++it) {
-				where_ = Node::link(where_.base(), Node::self(new node_type(*it)));
+				where_ = Node::link(where_.base(), Node::create_node(*it));
 			}
 			return iterator<U>(where_);
 		}
@@ -1798,7 +4203,32 @@ namespace nsOutTree
 		{
 			validate_destination(where_);
 			return iterator<U>(
-				Node::link(where_.base(), Node::self(new node_type(std::forward<Args>(args)...)))
+				Node::link(where_.base(), Node::create_node(std::forward<Args>(args)...))
+			);
+		}
+
+		// @brief  Constructs an element as the last child of 'parent_' while other threads append as well.
+		//         Lock-free; other modifications of the container must not run at the same time.
+		//         Requires ConcurrentTraits.
+		//         Each append claims the end of the list first and links the previous last child to the new
+		//         node second. A forward reader stops at the last node whose successor is linked: an appender
+		//         stalled between its two steps hides its node and all nodes appended after it (by any thread)
+		//         until it resumes, and the child count and sizes may already include them. Once every
+		//         concurrent_emplace_back call has returned, all appended nodes are visible.
+		//
+		// @param parent_  The parent node; an iterator without a node (such as parent() of a top-level node)
+		//                 appends at the top level.
+		// @param args  Arguments perfectly forwarded to the constructor of `value_type`.
+		// @return  An `iterator<U>` to the new element.
+		// @throws  std::invalid_argument If 'parent_' points to a sentinel node.
+		template <bool B, typename U, typename... Args>
+		iterator<U> concurrent_emplace_back(generic_iterator<B, U> parent_, Args&&... args)
+		{
+			if (parent_.base()) { validate_source(parent_); }
+			return iterator<U>(
+				Node::concurrent_append(
+					(parent_.base() ? parent_.base() : pRoot),
+					Node::create_node(std::forward<Args>(args)...))
 			);
 		}
 
@@ -1965,6 +4395,101 @@ namespace nsOutTree
 			return self_type{ it_ };
 		}
 
+		// @brief  Moves the nodes into 'count_' containers of about equal size, leaving this container empty.
+		//
+		// The pieces are the top-level subtrees or, with 'split_large_', the nodes of the subtrees larger than
+		// size() / count_ taken one by one and their children as pieces of their own (recursively). The largest
+		// pieces are placed first, each on the least loaded shard; every shard keeps its pieces in the original order.
+		// Each piece is spliced in O(depth): no node is allocated or copied, and only the split subtrees are walked.
+		//
+		// @param count_  The number of shards.
+		// @param split_large_  Whether subtrees larger than the share of one shard are divided.
+		// @return  The shards, to be handed back to merge_shards() of this container.
+		// @throws  std::invalid_argument If `count_` is 0.
+		Shards shard(size_type count_, bool split_large_ = false)
+		{
+			if (!count_) {
+				throw std::invalid_argument("Attempted to create zero shards.");
+			}
+			struct piece_type { node_pointer node; size_type size; };
+			const size_type share_{ size() / count_ };
+
+			// Pieces in pre-order; the children of divided subtrees follow their root
+			std::vector<piece_type> pieces_;
+			std::vector<std::pair<node_pointer, node_pointer>> ranges_{ { Node::get_begin(pRoot), Node::get_end(pRoot) } };
+			while (!ranges_.empty()) {
+				auto& range_ = ranges_.back();
+				if (range_.first == range_.second) {
+					ranges_.pop_back();
+					continue;
+				}
+				const auto node_ = range_.first;
+				range_.first = FlatTraversePolicy::policy_next(node_);
+				const auto size_ = Node::get_size(node_);
+				if (split_large_ and (size_ > share_) and Node::has_children(node_)) {
+					pieces_.push_back({ node_, 1 });
+					ranges_.emplace_back(Node::get_begin(node_), Node::get_end(node_));
+				}
+				else {
+					pieces_.push_back({ node_, size_ });
+				}
+			}
+
+			// Largest pieces first, each on the least loaded shard (ties go to the lower shard number)
+			std::vector<size_type> order_(pieces_.size());
+			for (size_type i_{}; i_ != order_.size(); ++i_) { order_[i_] = i_; }
+			std::stable_sort(order_.begin(), order_.end(),
+				[&pieces_](size_type lhs_, size_type rhs_) { return pieces_[lhs_].size > pieces_[rhs_].size; });
+			std::vector<std::pair<size_type, size_type>> loads_;  // Min-heap of {load, shard}
+			for (size_type i_{}; i_ != count_; ++i_) { loads_.emplace_back(0, i_); }
+			std::vector<size_type> target_(pieces_.size());
+			for (auto piece_ : order_) {
+				std::pop_heap(loads_.begin(), loads_.end(), std::greater<>{});
+				loads_.back().first += pieces_[piece_].size;
+				target_[piece_] = loads_.back().second;
+				std::push_heap(loads_.begin(), loads_.end(), std::greater<>{});
+			}
+
+			// Splices in pre-order, so that the children of a divided subtree leave it after it has moved
+			Shards shards_;
+			shards_.vShards.resize(count_);
+			shards_.vMoves.reserve(pieces_.size());
+			for (size_type i_{}; i_ != pieces_.size(); ++i_) {
+				const auto node_ = pieces_[i_].node;
+				shards_.vMoves.emplace_back(node_, FlatTraversePolicy::policy_next(node_));
+				Node::move(Node::get_end(shards_.vShards[target_[i_]].pRoot), node_);
+			}
+			return shards_;
+		}
+
+		// @brief  Moves the nodes of shards made by shard() of this container back to their original places.
+		//
+		// The splices are undone in reverse order in O(depth) each; top-level nodes added to the shards meanwhile
+		// are appended after the restored ones, in shard order.
+		//
+		// @param shards_  The shards, left empty.
+		void merge_shards(Shards& shards_)
+		{
+			while (!shards_.vMoves.empty()) {
+				const auto move_ = shards_.vMoves.back();
+				shards_.vMoves.pop_back();
+				Node::move(move_.second, move_.first);
+			}
+			for (auto& shard_ : shards_.vShards) {
+				if (!shard_.empty()) {
+					Node::template move<FlatTraversePolicy>(
+						Node::get_end(pRoot), Node::get_begin(shard_.pRoot), Node::get_end(shard_.pRoot)
+					);
+				}
+			}
+			shards_.vShards.clear();
+		}
+		// @brief  Moves the nodes of shards made by shard() of this container back to their original places.
+		void merge_shards(Shards&& shards_)
+		{
+			merge_shards(shards_);
+		}
+
 		// @brief  Compares two individual nodes using a custom binary predicate.
 		//
 		// @tparam BinPred_  The type of the binary predicate for comparison.
@@ -2042,6 +4567,30 @@ namespace nsOutTree
 			);
 		}
 
+		// @brief  Compares two ranges of nodes (and their subtrees) on several threads.
+		//
+		// @tparam BinPred_  The type of the binary predicate for comparison (must be safe to call concurrently).
+		// @param first_begin_  An iterator to the beginning of the first range.
+		// @param first_end_  An iterator to the end of the first range.
+		// @param second_begin_  An iterator to the beginning of the second range.
+		// @param second_end_  An iterator to the end of the second range.
+		// @param is_equal_  A binary predicate that returns true if two elements are considered equal (defaults to std::equal_to<>()).
+		// @param thread_count_  The number of threads to use (0 selects std::thread::hardware_concurrency()).
+		// @return  True if the two ranges are element-wise equal according to 'is_equal_', false otherwise.
+		template <bool Bf, bool Bs, typename U, typename BinPred_ = std::equal_to<>>
+		std::enable_if_t<std::is_same_v<U, FlatTraversePolicy>, bool>
+			parallel_deep_compare(generic_iterator<Bf, U> first_begin_, generic_iterator<Bf, U> first_end_,
+			generic_iterator<Bs, U> second_begin_, generic_iterator<Bs, U> second_end_, BinPred_&& is_equal_ = {},
+			size_type thread_count_ = 0)
+		{
+			validate_range(first_begin_, first_end_);
+			validate_range(second_begin_, second_end_);
+			return Node::template parallel_deep_compare<U>(
+				first_begin_.base(), first_end_.base(), second_begin_.base(), second_end_.base(),
+				std::forward<BinPred_>(is_equal_), thread_count_
+			);
+		}
+
 		// @brief  Swaps the positions of two nodes within the container structure.
 		//
 		// @param first_  An iterator pointing to the first node to be swapped.
@@ -2056,6 +4605,120 @@ namespace nsOutTree
 			Node::swap_nodes(first_.base(), second_.base());
 		}
 
+		// @brief  Finds a direct child of the node indicated by 'it_' by its key.
+		//
+		// @param it_  An iterator pointing to the parent node.
+		// @param key_  The key to look for, as extracted by the key_of of the traits.
+		// @return  A `flat_iterator` to the child, or the end iterator of the children of 'it_' if no child has this key.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		// @note  O(1) on average once the node holds more children than the traits threshold, linear below it.
+		//        If several children share a key, which one is returned is unspecified.
+		//        Values of keyed containers are read-only through iterators; modify() and the transforms re-file them.
+		template <bool B, typename U>
+		const_flat_iterator find_child(generic_iterator<B, U> it_, const key_type& key_) const
+		{
+			validate_source(it_);
+			return const_flat_iterator(
+				Node::find_child(it_.base(), key_)
+			);
+		}
+		// @brief  Finds a direct child of the node indicated by 'it_' by its key.
+		template <bool B, typename U>
+		flat_iterator find_child(generic_iterator<B, U> it_, const key_type& key_)
+		{
+			return flat_iterator(
+				static_cast<const self_type*>(this)->find_child(it_, key_)
+			);
+		}
+
+		// @brief  Stably sorts the children of the node indicated by 'it_'.
+		//
+		// @tparam Compare_  The type of the comparison predicate.
+		// @param it_  An iterator pointing to the node whose children will be sorted.
+		// @param comp_  A binary predicate ordering two elements (defaults to std::less<>()).
+		//               If it throws, the child list being sorted is left unchanged.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		// @note  Nodes are relinked in place: no value is copied and all iterators remain valid.
+		template <bool B, typename U, typename Compare_ = std::less<>>
+		void sort_children(generic_iterator<B, U> it_, Compare_&& comp_ = {})
+		{
+			validate_source(it_);
+			Node::sort_children(it_.base(), std::forward<Compare_>(comp_));
+		}
+
+		// @brief  Stably sorts the children of the node indicated by 'it_' and of all its descendants.
+		//
+		// @tparam Compare_  The type of the comparison predicate.
+		// @param it_  An iterator pointing to the root of the subtree to be sorted.
+		// @param comp_  A binary predicate ordering two elements (defaults to std::less<>()).
+		//               If it throws, the child lists sorted so far stay sorted and the others unchanged.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		// @note  Nodes are relinked in place: no value is copied and all iterators remain valid.
+		template <bool B, typename U, typename Compare_ = std::less<>>
+		void sort_subtree(generic_iterator<B, U> it_, Compare_&& comp_ = {})
+		{
+			validate_source(it_);
+			Node::sort_subtree(it_.base(), std::forward<Compare_>(comp_));
+		}
+
+		// @brief  Builds a container of another value type with the shape of the subtree indicated by 'it_'.
+		//
+		// @tparam V  The value type of the resulting container.
+		// @tparam VTraits  The traits of the resulting container (defaults to BasicTraits<V>).
+		// @param it_  An iterator pointing to the node that becomes the single top-level node of the result.
+		// @param op_  A unary operation returning the new value (convertible to V) for each element.
+		// @return  The resulting container; sizes and child counts are set once per node.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		template <typename V, typename VTraits = BasicTraits<V>, bool B, typename U, typename UnOp_>
+		Container<V, VTraits> transform(generic_iterator<B, U> it_, UnOp_&& op_) const
+		{
+			validate_source(it_);
+			const_node_pointer node_{ it_.base() };
+			return transform_impl<V, VTraits>(node_, FlatTraversePolicy::policy_next(node_), op_);
+		}
+
+		// @brief  Applies 'op_' to every element of the subtree indicated by 'it_' in place.
+		//
+		// @param it_  An iterator pointing to the root of the subtree.
+		// @param op_  A unary operation whose result is assigned back to the element, or which
+		//             modifies its (non-const) argument and returns void.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		template <bool B, typename U, typename UnOp_>
+		void transform_values(generic_iterator<B, U> it_, UnOp_&& op_)
+		{
+			validate_source(it_);
+			const auto node_ = it_.base();
+			Node::modify(node_, [&op_](reference value_) { transform_value(value_, op_); });
+			transform_children(node_, op_);
+		}
+
+		// @brief  Applies 'op_' to the element indicated by 'it_' in place (keeping the child index current, see KeyedTraits).
+		//
+		// @param it_  An iterator pointing to the element.
+		// @param op_  A unary operation whose result is assigned back to the element, or which
+		//             modifies its (non-const) argument and returns void.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		template <bool B, typename U, typename UnOp_>
+		void modify(generic_iterator<B, U> it_, UnOp_&& op_)
+		{
+			validate_source(it_);
+			Node::modify(it_.base(), [&op_](reference value_) { transform_value(value_, op_); });
+		}
+
+		// @brief  Walks the subtree indicated by 'it_' without recursion, reporting entering and leaving each node.
+		//
+		// @param it_  An iterator pointing to the root of the subtree (reported at depth 0).
+		// @param visitor_  An object providing enter(const_reference, size_type depth), called before the
+		//                  descendants of a node, and leave(const_reference, size_type depth), called after them.
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		template <bool B, typename U, typename Visitor_>
+		void for_each_event(generic_iterator<B, U> it_, Visitor_&& visitor_) const
+		{
+			validate_source(it_);
+			const_node_pointer node_{ it_.base() };
+			for_each_event_impl(node_, FlatTraversePolicy::policy_next(node_), visitor_);
+		}
+
 		// @brief  Removes the node (and its entire subtree) indicated by the iterator.
 		//
 		// @param it_  An iterator pointing to the node to be removed.
@@ -2070,6 +4733,23 @@ namespace nsOutTree
 			);
 		}
 
+		// @brief  Removes the node (and its entire subtree) indicated by the iterator, leaving the nodes to be
+		//         freed on the background thread of the reclaimer (see DeferredTraits); costs O(depth).
+		//         Values are destroyed on that thread, not the caller's; Reclaimer::drain() waits until they are.
+		//         Not available when the traits define a node_allocator (such as RelocatableTraits).
+		//
+		// @param it_  An iterator pointing to the node to be removed.
+		// @return  An iterator to the element immediately following the removed node (or the end iterator if no such element).
+		// @throws  std::invalid_argument If `it_` is an invalid iterator or points to a sentinel node.
+		template <bool B, typename U>
+		iterator<U> remove_deferred(generic_iterator<B, U> it_)
+		{
+			validate_source(it_);
+			return iterator<U>(
+				Node::remove_deferred(it_.base())
+			);
+		}
+
 		// @brief  Removes all nodes from the container whose data matches the given value.
 		//
 		// @param value_  The constant reference to the value to be removed from the container.
@@ -2110,23 +4790,177 @@ namespace nsOutTree
 		void clear(generic_iterator<B, U> it_)
 		{
 			validate_source(it_);
-			Node::template remove_if<U>(
-				Node::get_begin(it_.base()), Node::get_end(it_.base()),
-				[](auto) { return true; }
-			);
+			if constexpr (Node::is_deferred) {
+				Node::remove_children_deferred(it_.base());
+			}
+			else {
+				Node::template remove_if<U>(
+					Node::get_begin(it_.base()), Node::get_end(it_.base()),
+					[](auto) { return true; }
+				);
+			}
 		}
 
 
 	public:
-		// Clears the entire container
+		// Clears the entire container (with DeferredTraits only the top level is walked; the reclaimer frees the rest)
 		void clear()
 		{
-			Node::template remove_if<typename Node::PreorderTraversePolicy_>(
-				Node::get_begin(pRoot), Node::get_end(pRoot),
-				[](auto) { return true; }
+			if constexpr (Node::is_deferred) {
+				Node::remove_children_deferred(pRoot);
+			}
+			else {
+				Node::template remove_if<typename Node::PreorderTraversePolicy_>(
+					Node::get_begin(pRoot), Node::get_end(pRoot),
+					[](auto) { return true; }
+				);
+			}
+		}
+
+		// Finds a top-level node by its key (or returns the end of the flat view)
+		const_flat_iterator find_child(const key_type& key_) const
+		{
+			return const_flat_iterator(
+				Node::find_child(pRoot, key_)
+			);
+		}
+		// Finds a top-level node by its key (or returns the end of the flat view)
+		flat_iterator find_child(const key_type& key_)
+		{
+			return flat_iterator(
+				static_cast<const self_type*>(this)->find_child(key_)
+			);
+		}
+
+		// Resolves a path of keys [begin, end) from the top-level nodes (or returns the end of the flat view)
+		template <typename InputIt>
+		const_flat_iterator find_path(InputIt begin_, InputIt end_) const
+		{
+			node_pointer node_{ pRoot };
+			for (; begin_ != end_ and !Node::is_sentinel(node_); ++begin_) {
+				node_ = Node::find_child(node_, *begin_);
+			}
+			return const_flat_iterator(
+				(node_ == pRoot or Node::is_sentinel(node_)) ? Node::get_end(pRoot) : node_
+			);
+		}
+		// Resolves a path of keys [begin, end) from the top-level nodes (or returns the end of the flat view)
+		template <typename InputIt>
+		flat_iterator find_path(InputIt begin_, InputIt end_)
+		{
+			return flat_iterator(
+				static_cast<const self_type*>(this)->find_path(begin_, end_)
+			);
+		}
+
+		// Stably sorts the top-level nodes and every child list of the container (relinks only)
+		template <typename Compare_ = std::less<>>
+		void sort(Compare_&& comp_ = {})
+		{
+			Node::sort_subtree(pRoot, std::forward<Compare_>(comp_));
+		}
+
+		// Builds a container of value type V with the same shape, each value being op_(value)
+		template <typename V, typename VTraits = BasicTraits<V>, typename UnOp_>
+		Container<V, VTraits> transform(UnOp_&& op_) const
+		{
+			return transform_impl<V, VTraits>(
+				Node::get_begin(const_node_pointer(pRoot)), Node::get_end(const_node_pointer(pRoot)), op_
+			);
+		}
+
+		// Applies op_ to every element in place (assigns its result, unless op_ returns void)
+		template <typename UnOp_>
+		void transform_values(UnOp_&& op_)
+		{
+			transform_children(pRoot, op_);
+		}
+
+		// Same as transform_values(), with op_ called concurrently on the shared pool (see PreorderView::parallel_transform_values)
+		template <typename UnOp_>
+		void parallel_transform_values(UnOp_&& op_, size_type grain_ = 0)
+		{
+			as_preorder().parallel_transform_values(std::forward<UnOp_>(op_), grain_);
+		}
+
+		// Removes the nodes whose value satisfies pr_, evaluated concurrently on the shared pool (see PreorderView::parallel_remove_if)
+		template <typename UnPred_>
+		size_type parallel_remove_if(UnPred_&& pr_, size_type grain_ = 0)
+		{
+			return as_preorder().parallel_remove_if(std::forward<UnPred_>(pr_), grain_);
+		}
+
+		// Walks the whole container, calling visitor_.enter(value, depth) and visitor_.leave(value, depth)
+		template <typename Visitor_>
+		void for_each_event(Visitor_&& visitor_) const
+		{
+			for_each_event_impl(Node::get_begin(const_node_pointer(pRoot)), Node::get_end(const_node_pointer(pRoot)), visitor_);
+		}
+
+	private:
+		// Reports the events of the sibling range [first, last) to the visitor
+		template <typename Visitor_>
+		static void for_each_event_impl(const_node_pointer first_, const_node_pointer last_, Visitor_& visitor_)
+		{
+			Node::for_each_event(
+				first_, last_,
+				[&visitor_](const_node_pointer node_, size_type depth_) { visitor_.enter(Node::data_ref(node_), depth_); },
+				[&visitor_](const_node_pointer node_, size_type depth_) { visitor_.leave(Node::data_ref(node_), depth_); }
+			);
+		}
+
+		// Copies the shape of the sibling range [first, last) into a new container, converting each value
+		template <typename V, typename VTraits, typename UnOp_>
+		static Container<V, VTraits> transform_impl(const_node_pointer first_, const_node_pointer last_, UnOp_& op_)
+		{
+			using result_type = Container<V, VTraits>;
+			result_type cont_;
+			typename result_type::Node::PreorderBuilder builder_(cont_.pRoot);
+			Node::for_each_depth(
+				first_, last_,
+				[&builder_, &op_](const_node_pointer node_, size_type depth_) {
+					builder_.push(static_cast<typename result_type::size_type>(depth_), std::invoke(op_, Node::data_ref(node_)));
+				}
 			);
+			builder_.finish();
+			return cont_;
+		}
+
+		// Applies op_ to the descendants of node in pre-order; with a key, the child index of every node whose
+		// children were modified is rebuilt once they all are (also when op_ throws)
+		template <typename UnOp_>
+		static void transform_children(node_pointer node_, UnOp_& op_)
+		{
+			auto transform_ = [&op_](node_pointer node_, size_type) { transform_value(Node::data_ref(node_), op_); };
+			if constexpr (is_keyed) {
+				auto reindex_ = [](node_pointer node_, size_type) { Node::reindex(node_); };
+				try { Node::for_each_event(Node::get_begin(node_), Node::get_end(node_), transform_, reindex_); }
+				catch (...) {
+					Node::for_each_depth(Node::get_begin(node_), Node::get_end(node_), reindex_);
+					Node::reindex(node_);
+					throw;
+				}
+				Node::reindex(node_);
+			}
+			else {
+				Node::for_each_depth(Node::get_begin(node_), Node::get_end(node_), transform_);
+			}
+		}
+
+		// Applies op_ to a single element
+		template <typename UnOp_>
+		static void transform_value(reference value_, UnOp_& op_)
+		{
+			if constexpr (std::is_void_v<std::invoke_result_t<UnOp_&, reference>>) {
+				std::invoke(op_, value_);
+			}
+			else {
+				value_ = std::invoke(op_, value_);
+			}
 		}
 
+	public:
+
 		// Returns the total number of nodes in the container
 		size_type size() const
 		{
@@ -2156,6 +4990,175 @@ namespace nsOutTree
 			return Node::formatted_stream(os_, pRoot);
 		}
 
+		// Returns the formatted output of the entire container structure as a string
+		std::string to_string() const
+		{
+			return Node::formatted_string(pRoot);
+		}
+
+		// Hands the formatted output of the entire container structure to sink_(const char* data, size_type count)
+		// in chunks of about 64 KiB
+		template <typename Sink_>
+		void to_sink(Sink_&& sink_) const
+		{
+			Node::formatted_sink(std::forward<Sink_>(sink_), pRoot);
+		}
+
+		// @brief  Writes the container in the compact binary format.
+		//
+		// @param os_  The output stream (written through its stream buffer, in chunks).
+		// @param codec_  The value codec, providing write(BinaryWriter&, const value_type&).
+		// @throws  std::runtime_error If the stream does not accept the data.
+		// @note  Layout: magic "OTB1", varint node count, varint top-level count, then per node in
+		//        pre-order its varint child count followed by the encoded value.
+		template <typename Codec_ = BinaryCodec<value_type>>
+		void serialize(std::ostream& os_, const Codec_& codec_ = {}) const
+		{
+			BinaryWriter writer_(os_);
+			serialize_impl(writer_, codec_);
+			writer_.flush();
+		}
+		// @brief  Same as above, appending the binary data to 'buffer_'.
+		template <typename Codec_ = BinaryCodec<value_type>>
+		void serialize(std::string& buffer_, const Codec_& codec_ = {}) const
+		{
+			BinaryWriter writer_(buffer_);
+			serialize_impl(writer_, codec_);
+		}
+
+		// @brief  Reads a container written by serialize() in a single pass without recursion.
+		//
+		// @param is_  The input stream; nothing past the serialized container is consumed.
+		// @param codec_  The value codec, providing value_type read(BinaryReader&).
+		// @return  The reconstructed container.
+		// @throws  std::runtime_error If the data is truncated or malformed.
+		template <typename Codec_ = BinaryCodec<value_type>>
+		static self_type deserialize(std::istream& is_, const Codec_& codec_ = {})
+		{
+			BinaryReader reader_(is_);
+			return deserialize_impl(reader_, codec_);
+		}
+		// @brief  Same as above, reading from a byte range.
+		template <typename Codec_ = BinaryCodec<value_type>>
+		static self_type deserialize(std::string_view bytes_, const Codec_& codec_ = {})
+		{
+			BinaryReader reader_(bytes_);
+			return deserialize_impl(reader_, codec_);
+		}
+
+		// @brief  Reads the text written by operator<< (or to_string()) in a single pass without recursion.
+		//
+		// @param text_  One node per line: 8 spaces per level past the first and "|------ " before nested
+		//               values, or "<empty>". Text starting with "[0] " and ending with a "Size: " line is
+		//               read as debug output, where every line has a "[depth] " prefix. A trailing '\r' is
+		//               dropped from each line.
+		// @param parser_  Called as parser_(std::string_view) with the text of each value, returning the value.
+		// @return  The constructed container.
+		// @throws  std::invalid_argument If a line is more than one level deeper than the previous one,
+		//          or a debug prefix is missing or does not match the depth.
+		template <typename ValueParser_>
+		static self_type parse(std::string_view text_, ValueParser_&& parser_)
+		{
+			self_type cont_;
+			if ((text_ == "<empty>") or (text_ == "<empty>\n") or (text_ == "<empty>\r\n")) { return cont_; }
+
+			constexpr std::string_view indent_{ "        " }, marker_{ "|------ " };
+			auto last_ = text_.substr(0, text_.find_last_not_of("\r\n") + 1);
+			last_.remove_prefix((std::min)(last_.rfind('\n') + 1, last_.size()));
+			const bool debug_ = (text_.substr(0, 4) == "[0] ") and (last_.substr(0, 6) == "Size: ");
+
+			typename Node::PreorderBuilder builder_(cont_.pRoot);
+			size_type line_{};
+			while (!text_.empty()) {
+				const auto eol_ = (std::min)(text_.find('\n'), text_.size());
+				auto rest_ = text_.substr(0, eol_);
+				text_.remove_prefix((std::min)(eol_ + 1, text_.size()));
+				++line_;
+				if (!rest_.empty() and (rest_.back() == '\r')) { rest_.remove_suffix(1); }
+				if (debug_ and (rest_.data() == last_.data())) { break; }  // Footer
+
+				// Indentation followed by the marker gives the depth, anything else is a top-level value
+				size_type depth_{}, levels_{};
+				while (rest_.substr(levels_ * indent_.size(), indent_.size()) == indent_) { ++levels_; }
+				if (rest_.substr(levels_ * indent_.size(), marker_.size()) == marker_) {
+					depth_ = levels_ + 1;
+					rest_.remove_prefix(levels_ * indent_.size() + marker_.size());
+				}
+
+				if (debug_) {
+					size_type prefix_{};
+					const auto [end_, error_] = std::from_chars(rest_.data() + (std::min)(rest_.size(), size_type{ 1 }), rest_.data() + rest_.size(), prefix_);
+					const auto length_ = static_cast<size_type>(end_ - rest_.data());
+					if ((rest_.substr(0, 1) != "[") or (error_ != std::errc{}) or (prefix_ != depth_) or (rest_.substr(length_, 2) != "] ")) {
+						throw std::invalid_argument("Line " + std::to_string(line_) + " has no matching depth prefix.");
+					}
+					rest_.remove_prefix(length_ + 2);
+				}
+
+				if (depth_ > builder_.depth()) {
+					throw std::invalid_argument("Line " + std::to_string(line_) + " skips a level of the hierarchy.");
+				}
+				builder_.push(depth_, std::invoke(parser_, rest_));
+			}
+			builder_.finish();
+			return cont_;
+		}
+
+	private:
+		// Magic bytes opening the binary format
+		static constexpr char binary_magic[4]{ 'O', 'T', 'B', '1' };
+
+		// Writes the header and the nodes in pre-order
+		template <typename Codec_>
+		void serialize_impl(BinaryWriter& writer_, const Codec_& codec_) const
+		{
+			writer_.write(binary_magic, sizeof(binary_magic));
+			writer_.write_varint(size());
+			writer_.write_varint(Node::get_child_count(pRoot));
+			Node::for_each_depth(
+				Node::get_begin(const_node_pointer(pRoot)), Node::get_end(const_node_pointer(pRoot)),
+				[&writer_, &codec_](const_node_pointer node_, size_type) {
+					writer_.write_varint(Node::get_child_count(node_));
+					codec_.write(writer_, Node::data_ref(node_));
+				}
+			);
+		}
+
+		// Rebuilds the nodes through the pre-order builder, tracking the children left per open level
+		template <typename Codec_>
+		static self_type deserialize_impl(BinaryReader& reader_, const Codec_& codec_)
+		{
+			char magic_[sizeof(binary_magic)];
+			reader_.read(magic_, sizeof(magic_));
+			if (std::memcmp(magic_, binary_magic, sizeof(magic_)) != 0) {
+				throw std::runtime_error("Invalid binary header.");
+			}
+			const auto count_ = reader_.read_varint();
+
+			self_type cont_;
+			typename Node::PreorderBuilder builder_(cont_.pRoot);
+			std::vector<std::uint64_t> remaining_{ reader_.read_varint() };
+			std::uint64_t read_{};
+			while (!remaining_.empty()) {
+				if (remaining_.back() == 0u) {
+					remaining_.pop_back();
+					continue;
+				}
+				--remaining_.back();
+				if (++read_ > count_) {
+					throw std::runtime_error("Binary data holds more nodes than its header.");
+				}
+				const auto children_ = reader_.read_varint();
+				builder_.push(static_cast<size_type>(remaining_.size() - 1u), codec_.read(reader_));
+				remaining_.push_back(children_);
+			}
+			if (read_ != count_) {
+				throw std::runtime_error("Binary data holds fewer nodes than its header.");
+			}
+			builder_.finish();
+			return cont_;
+		}
+
 	};
 
 
@@ -2170,10 +5173,11 @@ namespace nsOutTree
 		using self_type          = Iterator;
 		using iterator_category  = std::bidirectional_iterator_tag;
 		using value_type         = typename container_type::value_type;
-		using pointer            = typename container_type::pointer;
 		using const_pointer      = typename container_type::const_pointer;
-		using reference          = typename container_type::reference;
 		using const_reference    = typename container_type::const_reference;
+		// Read-only access for const iterators and when the values carry the keys of a child index (see Container::modify)
+		using pointer            = std::conditional_t<Const or container_type::is_keyed, const_pointer, typename container_type::pointer>;
+		using reference          = std::conditional_t<Const or container_type::is_keyed, const_reference, typename container_type::reference>;
 		using difference_type    = typename container_type::difference_type;
 		using size_type          = typename container_type::size_type;
 
@@ -2203,6 +5207,8 @@ namespace nsOutTree
 		// Friend declarations
 		template <typename, bool, typename> friend class Iterator;
 		friend class container_type::self_type;
+		template <typename> friend class ConcurrentContainer;
+		template <typename> friend class LockedContainer;
 
 
 	private:
@@ -2266,6 +5272,7 @@ namespace nsOutTree
 		}
 
 
+
 		// Returns the underlying node const pointer
 		const_node_pointer base() const
 		{
@@ -2690,6 +5697,13 @@ namespace nsOutTree
 		return !(lhs_ == rhs_);
 	}
 
+	// Applies op_ to every element of a pre-order or flat view in parallel (see PolicyView::parallel_for_each)
+	template <typename View_, typename UnOp_>
+	void parallel_for_each(View_&& view_, UnOp_&& op_, std::size_t grain_ = 0)
+	{
+		view_.parallel_for_each(std::forward<UnOp_>(op_), grain_);
+	}
+
 }
 
 
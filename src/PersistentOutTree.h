@@ -0,0 +1,515 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "OutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	//=== Immutable forest whose updates return new versions sharing the untouched subtrees ===//
+	//   Nodes are reference counted and never modified once published. They are created non-const and
+	//   shared as pointers to const, so the last owner may take their children apart when releasing them. An update copies the nodes on the
+	//   path from the top to the changed one (each with its array of child pointers) and shares the rest,
+	//   so it costs O(depth * children per node) whatever the size of the forest; old versions stay valid.
+	//   A version may be read from any thread, including while others derive new versions from it.
+	//   Nodes are identified by their pre-order index in a given version (as in SuccinctContainer);
+	//   subtree sizes are kept per node, so an index is found by walking down one path.
+	template <typename T>
+	class PersistentContainer
+	{
+	public:
+		// Standard type aliases
+		using self_type        = PersistentContainer;
+		using value_type       = T;
+		using const_pointer    = const T*;
+		using const_reference  = const T&;
+		using size_type        = std::size_t;
+		using difference_type  = std::ptrdiff_t;
+
+		// Returned for absent nodes; as a parent it stands for the top level, as a position for the end
+		static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+
+	private:
+		class Branch;
+		class Node;
+		using branch_ptr = std::shared_ptr<const Branch>;
+		using path_type  = std::vector<size_type>;  // Child positions from the top level down
+
+		//=== Child list shared by the top level and the nodes ===//
+		class Branch
+		{
+		public:
+			std::vector<branch_ptr> vChildren;
+			size_type nSize{};  // Nodes of the subtree (the node itself included, none for the top level)
+
+		public:
+			// Default constructor
+			Branch() = default;
+			// Copy constructor: shares the children
+			Branch(const Branch&) = default;
+			// Constructor taking the children and the size
+			Branch(std::vector<branch_ptr> children_, size_type size_) : vChildren{ std::move(children_) }, nSize{ size_ } {}
+			// Deleted operators
+			Branch& operator =(const Branch&) = delete;
+			// Destructor: releases the subtrees no other version holds without recursion
+			~Branch()
+			{
+				std::vector<branch_ptr> pending_ = std::move(vChildren);
+				while (!pending_.empty()) {
+					branch_ptr last_ = std::move(pending_.back());
+					pending_.pop_back();
+					if (last_.use_count() == 1) {  // Sole owner: nobody can take a new reference
+						// Pairs with the release of the other owners' decrements before their last use of the node
+						std::atomic_thread_fence(std::memory_order_acquire);
+						auto& children_ = const_cast<Branch&>(*last_).vChildren;  // Created non-const
+						std::move(children_.begin(), children_.end(), std::back_inserter(pending_));
+						children_.clear();
+					}
+				}
+			}
+		};
+
+		//=== Node: a child list with a value ===//
+		class Node : public Branch
+		{
+		public:
+			T value;
+
+		public:
+			// Copy constructor: shares the children
+			Node(const Node&) = default;
+			// Constructor taking the value, the children and the size
+			template <typename U>
+			Node(U&& value_, std::vector<branch_ptr> children_, size_type size_)
+				: Branch(std::move(children_), size_), value(std::forward<U>(value_)) {}
+			// Deleted operators
+			Node& operator =(const Node&) = delete;
+		};
+
+		// Nodes from the top level down to a node, and the child positions leading to it
+		struct Location
+		{
+			std::vector<const Branch*> vChain;  // vChain[0] is the top level
+			path_type vPath;                    // vChain[i + 1] is child vPath[i] of vChain[i]
+		};
+
+
+	private:
+		branch_ptr pRoot;
+
+
+	public:
+		// Default constructor: an empty forest
+		PersistentContainer() : pRoot{ std::make_shared<Branch>() } {}
+
+		// Constructor copying a container
+		template <typename TTraits>
+		explicit PersistentContainer(const Container<T, TTraits>& cont_)
+		{
+			// Open nodes, innermost last, with the index past their subtree
+			std::vector<std::pair<std::shared_ptr<Node>, size_type>> open_;
+			auto root_ = std::make_shared<Branch>(std::vector<branch_ptr>{}, static_cast<size_type>(cont_.size()));
+			auto close_ = [&open_, &root_]() {
+				branch_ptr done_ = std::move(open_.back().first);
+				open_.pop_back();
+				(open_.empty() ? static_cast<Branch&>(*root_) : *open_.back().first).vChildren.push_back(std::move(done_));
+			};
+
+			size_type index_{};
+			for (auto it_ = cont_.pre().begin(); it_ != cont_.pre().end(); ++it_, ++index_) {
+				while (!open_.empty() and (open_.back().second == index_)) { close_(); }
+				const auto size_ = static_cast<size_type>(it_().size()) + 1u;  // Descendants and the node itself
+				open_.emplace_back(std::make_shared<Node>(*it_, std::vector<branch_ptr>{}, size_), index_ + size_);
+			}
+			while (!open_.empty()) { close_(); }
+			pRoot = std::move(root_);
+		}
+
+		// @brief  Copies the version into a container (one linear pass through the pre-order builder).
+		//
+		// @tparam TTraits  The traits of the resulting container (defaults to BasicTraits<T>).
+		// @return  The copied container.
+		template <typename TTraits = BasicTraits<T>>
+		Container<T, TTraits> to_container() const
+		{
+			return Container<T, TTraits>::build_from_preorder(depth_iterator(pRoot.get()), depth_iterator());
+		}
+
+
+	public:
+		// Returns the total number of nodes
+		size_type size() const
+		{
+			return pRoot->nSize;
+		}
+		// Checks if the forest is empty
+		bool empty() const
+		{
+			return pRoot->vChildren.empty();
+		}
+
+		// Returns the value of node_
+		const_reference value(size_type node_) const
+		{
+			return as_node(locate(node_).vChain.back()).value;
+		}
+		// Returns the value of node_
+		const_reference operator [](size_type node_) const
+		{
+			return value(node_);
+		}
+
+		// Returns the parent of node_ (npos for top-level nodes)
+		size_type parent(size_type node_) const
+		{
+			const auto location_ = locate(node_);
+			return (location_.vPath.size() == 1u)
+				? npos
+				: index_of(location_, location_.vPath.size() - 1u);
+		}
+
+		// Returns the first child of node_ (npos for leaves)
+		size_type first_child(size_type node_) const
+		{
+			return locate(node_).vChain.back()->vChildren.empty() ? npos : node_ + 1u;
+		}
+
+		// Returns the next sibling of node_ (npos for the last child or the last top-level node)
+		size_type next_sibling(size_type node_) const
+		{
+			const auto location_ = locate(node_);
+			const auto& siblings_ = location_.vChain[location_.vChain.size() - 2u]->vChildren;
+			return (location_.vPath.back() + 1u < siblings_.size())
+				? node_ + location_.vChain.back()->nSize
+				: npos;
+		}
+
+		// Returns the number of nodes of the subtree of node_ (itself included)
+		size_type subtree_size(size_type node_) const
+		{
+			return locate(node_).vChain.back()->nSize;
+		}
+
+		// Returns the depth of node_ (0 for top-level nodes)
+		size_type depth(size_type node_) const
+		{
+			return locate(node_).vPath.size() - 1u;
+		}
+
+		// Returns the number of direct children of node_
+		size_type child_count(size_type node_) const
+		{
+			return locate(node_).vChain.back()->vChildren.size();
+		}
+
+		// @brief  Calls op_(value, depth) for every node in pre-order.
+		template <typename Operation_>
+		void for_each(Operation_&& op_) const
+		{
+			for (depth_iterator it_(pRoot.get()); it_ != depth_iterator(); ++it_) {
+				const auto entry_ = *it_;
+				op_(entry_.second, entry_.first);
+			}
+		}
+
+		// Checks if both versions are the same (they share every node)
+		bool same_version(const self_type& other_) const
+		{
+			return pRoot == other_.pRoot;
+		}
+
+		// Compares the shapes and values in pre-order (subtrees shared by both versions are not walked)
+		friend bool operator ==(const self_type& lhs_, const self_type& rhs_)
+		{
+			return equal_branches(lhs_.pRoot.get(), rhs_.pRoot.get());
+		}
+		friend bool operator !=(const self_type& lhs_, const self_type& rhs_)
+		{
+			return !(lhs_ == rhs_);
+		}
+
+
+	public:
+		// @brief  Returns a version with value_ inserted as child number 'position_' of 'parent_'.
+		//
+		// @param parent_    The parent node (npos for the top level).
+		// @param position_  The position among its children (npos to append).
+		// @param value_     The value of the new node.
+		// @return  The new version; this one is unchanged.
+		// @throws  std::out_of_range If `parent_` or `position_` is out of bounds.
+		template <typename U>
+		self_type insert(size_type parent_, size_type position_, U&& value_) const
+		{
+			return insert_subtree(parent_, position_,
+				std::make_shared<Node>(std::forward<U>(value_), std::vector<branch_ptr>{}, size_type{ 1 }));
+		}
+		// @brief  Returns a version with value_ appended to the children of 'parent_' (npos for the top level).
+		template <typename U>
+		self_type push_back(size_type parent_, U&& value_) const
+		{
+			return insert(parent_, npos, std::forward<U>(value_));
+		}
+
+		// @brief  Returns a version without node_ and its subtree.
+		//
+		// @return  The new version; this one is unchanged.
+		// @throws  std::out_of_range If `node_` is out of bounds.
+		self_type remove(size_type node_) const
+		{
+			return remove_path(locate(node_));
+		}
+
+		// @brief  Returns a version where the value of node_ is replaced by value_ (its subtree is shared).
+		//
+		// @return  The new version; this one is unchanged.
+		// @throws  std::out_of_range If `node_` is out of bounds.
+		template <typename U>
+		self_type update(size_type node_, U&& value_) const
+		{
+			const auto location_ = locate(node_);
+			const auto* node_branch_ = location_.vChain.back();
+			return rebuild(location_, location_.vPath.size(), std::make_shared<Node>(
+				std::forward<U>(value_), node_branch_->vChildren, node_branch_->nSize), 0);
+		}
+
+		// @brief  Returns a version where node_ and its subtree become child number 'position_' of 'parent_'.
+		//
+		// @param node_      The node to move.
+		// @param parent_    The new parent (npos for the top level), as indexed in this version.
+		// @param position_  The position among the current children of 'parent_' (npos to append).
+		// @return  The new version; this one is unchanged.
+		// @throws  std::out_of_range If `node_`, `parent_` or `position_` is out of bounds.
+		// @throws  std::invalid_argument If `parent_` lies in the subtree of `node_`.
+		self_type move(size_type node_, size_type parent_, size_type position_) const
+		{
+			const auto source_ = locate(node_);
+			const auto destination_ = locate_parent(parent_);
+			const auto count_ = destination_.vChain.back()->vChildren.size();
+			if (position_ == npos) { position_ = count_; }
+			if (position_ > count_) {
+				throw std::out_of_range("Attempted to access element out of bounds.");
+			}
+			const auto& from_ = source_.vPath;
+			auto target_ = destination_.vPath;
+
+			// The parent must not lie in the moved subtree
+			if ((target_.size() >= from_.size()) and std::equal(from_.begin(), from_.end(), target_.begin())) {
+				throw std::invalid_argument("Attempted to create a circular dependency.");
+			}
+			// Positions past the moved node shift down once it is gone
+			const auto level_ = from_.size() - 1u;
+			if (std::equal(from_.begin(), from_.begin() + level_, target_.begin(), target_.begin() + (std::min)(level_, target_.size()))) {
+				if ((target_.size() == level_) and (from_.back() < position_)) { --position_; }
+				else if ((target_.size() > level_) and (from_.back() < target_[level_])) { --target_[level_]; }
+			}
+
+			const auto moved_ = source_.vChain[level_]->vChildren[from_.back()];
+			const auto removed_ = remove_path(source_);
+			return removed_.insert_subtree(removed_.follow(target_), position_, moved_);
+		}
+
+
+	private:
+		//=== Input iterator yielding {depth, value} pairs in pre-order ===//
+		class depth_iterator
+		{
+		public:
+			using iterator_category  = std::input_iterator_tag;
+			using value_type         = std::pair<size_type, const T&>;
+			using difference_type    = std::ptrdiff_t;
+			using pointer            = void;
+			using reference          = value_type;
+
+		private:
+			// Child lists being walked and the position in each, innermost last (empty at the end)
+			std::vector<std::pair<const Branch*, size_type>> vStack;
+
+		public:
+			// Constructor: the end iterator
+			depth_iterator() = default;
+			// Constructor: the first node below root_
+			explicit depth_iterator(const Branch* root_)
+			{
+				if (!root_->vChildren.empty()) { vStack.emplace_back(root_, 0u); }
+			}
+
+			reference operator *() const
+			{
+				return { vStack.size() - 1u, as_node(current()).value };
+			}
+			depth_iterator& operator ++()
+			{
+				const auto* node_ = current();
+				if (!node_->vChildren.empty()) {
+					vStack.emplace_back(node_, 0u);
+					return *this;
+				}
+				while (!vStack.empty() and (++vStack.back().second == vStack.back().first->vChildren.size())) {
+					vStack.pop_back();
+				}
+				return *this;
+			}
+			friend bool operator ==(const depth_iterator& lhs_, const depth_iterator& rhs_)
+			{
+				return (lhs_.vStack.size() == rhs_.vStack.size())
+					and (lhs_.vStack.empty() or (lhs_.vStack.back() == rhs_.vStack.back()));
+			}
+			friend bool operator !=(const depth_iterator& lhs_, const depth_iterator& rhs_)
+			{
+				return !(lhs_ == rhs_);
+			}
+
+		private:
+			// Returns the node under the iterator
+			const Branch* current() const
+			{
+				return vStack.back().first->vChildren[vStack.back().second].get();
+			}
+		};
+
+
+	private:
+		// Constructor taking the top level of a version
+		explicit PersistentContainer(branch_ptr root_) : pRoot{ std::move(root_) } {}
+
+		// Returns the node part of a branch below the top level
+		static const Node& as_node(const Branch* branch_)
+		{
+			return static_cast<const Node&>(*branch_);
+		}
+
+		// Compares two child lists and the subtrees below them without recursion
+		static bool equal_branches(const Branch* lhs_, const Branch* rhs_)
+		{
+			std::vector<std::pair<const Branch*, const Branch*>> pending_{ { lhs_, rhs_ } };
+			while (!pending_.empty()) {
+				const auto [left_, right_] = pending_.back();
+				pending_.pop_back();
+				if (left_ == right_) { continue; }
+				if ((left_->nSize != right_->nSize) or (left_->vChildren.size() != right_->vChildren.size())) { return false; }
+				for (size_type i_{}; i_ != left_->vChildren.size(); ++i_) {
+					const auto* leftChild_ = left_->vChildren[i_].get();
+					const auto* rightChild_ = right_->vChildren[i_].get();
+					if ((leftChild_ != rightChild_) and !(as_node(leftChild_).value == as_node(rightChild_).value)) { return false; }
+					pending_.emplace_back(leftChild_, rightChild_);
+				}
+			}
+			return true;
+		}
+
+		// Walks down to the node with pre-order index node_
+		Location locate(size_type node_) const
+		{
+			if (node_ >= size()) {
+				throw std::out_of_range("Attempted to access element out of bounds.");
+			}
+			Location location_;
+			location_.vChain.push_back(pRoot.get());
+			for (;;) {
+				const auto& children_ = location_.vChain.back()->vChildren;
+				size_type position_{};
+				while (node_ >= children_[position_]->nSize) { node_ -= children_[position_++]->nSize; }
+				location_.vChain.push_back(children_[position_].get());
+				location_.vPath.push_back(position_);
+				if (node_ == 0) { return location_; }
+				--node_;  // Step past the node itself into its children
+			}
+		}
+
+		// Walks down to a parent (npos for the top level)
+		Location locate_parent(size_type parent_) const
+		{
+			if (parent_ != npos) { return locate(parent_); }
+			Location location_;
+			location_.vChain.push_back(pRoot.get());
+			return location_;
+		}
+
+		// Returns the pre-order index of the node reached after 'levels_' steps of location_
+		static size_type index_of(const Location& location_, size_type levels_)
+		{
+			size_type index_{ levels_ - 1u };
+			for (size_type level_{}; level_ != levels_; ++level_) {
+				const auto& children_ = location_.vChain[level_]->vChildren;
+				for (size_type position_{}; position_ != location_.vPath[level_]; ++position_) { index_ += children_[position_]->nSize; }
+			}
+			return index_;
+		}
+
+		// Returns the pre-order index of the node at path_ (npos for the empty path, the top level)
+		size_type follow(const path_type& path_) const
+		{
+			if (path_.empty()) { return npos; }
+			Location location_;
+			location_.vChain.push_back(pRoot.get());
+			for (auto position_ : path_) {
+				location_.vChain.push_back(location_.vChain.back()->vChildren[position_].get());
+			}
+			location_.vPath = path_;
+			return index_of(location_, path_.size());
+		}
+
+		// Copies a branch for modification (the top level stays a plain child list)
+		static std::shared_ptr<Branch> copy_of(const Branch* branch_, bool top_level_)
+		{
+			if (top_level_) { return std::make_shared<Branch>(*branch_); }
+			return std::make_shared<Node>(as_node(branch_));
+		}
+
+		// Returns the version where vChain[level_] of location_ is replaced by branch_, copying the path above it
+		// (delta_ is the change in the number of nodes)
+		self_type rebuild(const Location& location_, size_type level_, branch_ptr branch_, difference_type delta_) const
+		{
+			while (level_-- != 0) {
+				auto copy_ = copy_of(location_.vChain[level_], level_ == 0);
+				copy_->vChildren[location_.vPath[level_]] = std::move(branch_);
+				copy_->nSize = static_cast<size_type>(static_cast<difference_type>(copy_->nSize) + delta_);
+				branch_ = std::move(copy_);
+			}
+			return self_type(std::move(branch_));
+		}
+
+		// Returns the version with subtree_ inserted as child number 'position_' of 'parent_'
+		self_type insert_subtree(size_type parent_, size_type position_, branch_ptr subtree_) const
+		{
+			const auto location_ = locate_parent(parent_);
+			const auto level_ = location_.vPath.size();
+			auto copy_ = copy_of(location_.vChain.back(), level_ == 0);
+			if (position_ == npos) { position_ = copy_->vChildren.size(); }
+			if (position_ > copy_->vChildren.size()) {
+				throw std::out_of_range("Attempted to access element out of bounds.");
+			}
+			const auto delta_ = static_cast<difference_type>(subtree_->nSize);
+			copy_->vChildren.insert(copy_->vChildren.begin() + static_cast<difference_type>(position_), std::move(subtree_));
+			copy_->nSize += static_cast<size_type>(delta_);
+			return rebuild(location_, level_, std::move(copy_), delta_);
+		}
+
+		// Returns the version without the node at location_
+		self_type remove_path(const Location& location_) const
+		{
+			const auto level_ = location_.vPath.size() - 1u;
+			auto copy_ = copy_of(location_.vChain[level_], level_ == 0);
+			const auto delta_ = -static_cast<difference_type>(location_.vChain.back()->nSize);
+			copy_->vChildren.erase(copy_->vChildren.begin() + static_cast<difference_type>(location_.vPath.back()));
+			copy_->nSize = static_cast<size_type>(static_cast<difference_type>(copy_->nSize) + delta_);
+			return rebuild(location_, level_, std::move(copy_), delta_);
+		}
+	};
+
+}
+
+
+
+// Alias for the PersistentContainer class template in the global namespace
+template < typename T >
+using PersistentOutTree = nsOutTree::PersistentContainer<T>;
@@ -0,0 +1,476 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "OutTree.h"
+
+
+
+namespace nsOutTree
+{
+
+	//=== Read-only forest encoded as balanced parentheses plus a dense value array ===//
+	//   The shape takes 2 bits per node: a node is '(' (1) when entered in pre-order and ')' (0) when left.
+	//   Nodes are identified by their pre-order index, which is also their position in the value array.
+	//   Navigation relies on:
+	//     - rank1(i): number of '(' before bit i, sampled every 512 bits
+	//     - excess E(i) = 2 * rank1(i) - i, the depth after the first i bits
+	//     - a min-tree over the lowest excess of each 512-bit block, so that matching parentheses
+	//       (find_close) and enclosing ones (enclose) are found in O(log n) blocks
+	//   Overall the shape costs about 2.5 bits per node.
+	template <typename T>
+	class SuccinctContainer
+	{
+	public:
+		// Standard type aliases
+		using self_type        = SuccinctContainer;
+		using value_type       = T;
+		using const_pointer    = const T*;
+		using const_reference  = const T&;
+		using size_type        = std::size_t;
+		using difference_type  = std::ptrdiff_t;
+
+		// Returned for absent nodes (no parent, child or sibling)
+		static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+
+	private:
+		// Bits per sampled block (rank and excess samples)
+		static constexpr size_type block_bits{ 512 };
+		static constexpr size_type block_words{ block_bits / 64 };
+
+		using excess_type = std::int64_t;
+
+		// Excess of each byte when scanning it from its lowest bit
+		struct byte_table_type
+		{
+			std::array<std::int8_t, 256> delta{};     // Excess after all 8 bits
+			std::array<std::int8_t, 256> min_after{}; // Lowest excess after 1..8 bits
+			std::array<std::int8_t, 256> min_before{};// Lowest excess after 0..7 bits
+
+			byte_table_type()
+			{
+				for (int byte_{}; byte_ != 256; ++byte_) {
+					int excess_{}, after_{ 8 }, before_{ 0 };
+					for (int bit_{}; bit_ != 8; ++bit_) {
+						excess_ += ((byte_ >> bit_) & 1) ? 1 : -1;
+						after_ = (std::min)(after_, excess_);
+						if (bit_ != 7) { before_ = (std::min)(before_, excess_); }
+					}
+					delta[byte_] = static_cast<std::int8_t>(excess_);
+					min_after[byte_] = static_cast<std::int8_t>(after_);
+					min_before[byte_] = static_cast<std::int8_t>(before_);
+				}
+			}
+		};
+
+
+	private:
+		std::vector<T> vValues;              // Values in pre-order
+		std::vector<std::uint64_t> vBits;    // Balanced parentheses, bit i at (word i / 64, bit i % 64)
+		size_type nBits{};                   // 2 * number of nodes
+		std::vector<size_type> vRanks;       // '(' before each block
+		std::vector<excess_type> vMinTree;   // Min-tree over the lowest excess of each block (1-based heap)
+		size_type nLeaves{};                 // Leaves of the min-tree (a power of two)
+
+
+	public:
+		// Default constructor: an empty forest
+		SuccinctContainer() = default;
+
+		// Constructor encoding a container
+		template <typename TTraits>
+		explicit SuccinctContainer(const Container<T, TTraits>& cont_)
+		{
+			const auto count_ = static_cast<size_type>(cont_.size());
+			vValues.reserve(count_);
+			nBits = 2u * count_;
+			vBits.assign((nBits + 63u) / 64u, 0u);
+
+			// Indices past the subtree of the open nodes, innermost last
+			std::vector<size_type> open_;
+			size_type bit_{}, index_{};
+			for (auto it_ = cont_.pre().begin(); it_ != cont_.pre().end(); ++it_, ++index_) {
+				while (!open_.empty() and (open_.back() == index_)) {
+					open_.pop_back();
+					++bit_;  // ')'
+				}
+				vBits[bit_ / 64u] |= std::uint64_t{ 1 } << (bit_ % 64u);  // '('
+				++bit_;
+				vValues.push_back(*it_);
+				open_.push_back(index_ + it_().size() + 1u);
+			}
+			build_index();
+		}
+
+		// @brief  Decodes the forest into a container (one linear pass through the pre-order builder).
+		//
+		// @tparam TTraits  The traits of the resulting container (defaults to BasicTraits<T>).
+		// @return  The decoded container.
+		template <typename TTraits = BasicTraits<T>>
+		Container<T, TTraits> to_container() const
+		{
+			return Container<T, TTraits>::build_from_preorder(depth_iterator(this, 0u), depth_iterator(this, nBits));
+		}
+
+
+	public:
+		// Returns the total number of nodes
+		size_type size() const
+		{
+			return vValues.size();
+		}
+		// Checks if the forest is empty
+		bool empty() const
+		{
+			return vValues.empty();
+		}
+
+		// Returns the value of node_
+		const_reference value(size_type node_) const
+		{
+			return vValues.at(node_);
+		}
+		// Returns the value of node_ (unchecked)
+		const_reference operator [](size_type node_) const
+		{
+			return vValues[node_];
+		}
+
+		// Returns the parent of node_ (npos for top-level nodes)
+		size_type parent(size_type node_) const
+		{
+			const auto open_ = select1(checked(node_));
+			const auto depth_ = excess(open_);
+			if (depth_ == 0) { return npos; }
+			return rank1(bwd_search(open_, depth_ - 1));
+		}
+
+		// Returns the first child of node_ (npos for leaves)
+		size_type first_child(size_type node_) const
+		{
+			const auto open_ = select1(checked(node_));
+			return ((open_ + 1u < nBits) and bit(open_ + 1u)) ? node_ + 1u : npos;
+		}
+
+		// Returns the next sibling of node_ (npos for the last child or the last top-level node)
+		size_type next_sibling(size_type node_) const
+		{
+			const auto close_ = find_close(select1(checked(node_)));
+			return ((close_ + 1u < nBits) and bit(close_ + 1u)) ? rank1(close_ + 1u) : npos;
+		}
+
+		// Returns the number of nodes of the subtree of node_ (itself included)
+		size_type subtree_size(size_type node_) const
+		{
+			const auto open_ = select1(checked(node_));
+			return (find_close(open_) - open_ + 1u) / 2u;
+		}
+
+		// Returns the depth of node_ (0 for top-level nodes)
+		size_type depth(size_type node_) const
+		{
+			return static_cast<size_type>(excess(select1(checked(node_))));
+		}
+
+		// Returns the number of direct children of node_ (walks the children)
+		size_type child_count(size_type node_) const
+		{
+			size_type count_{};
+			for (auto it_ = first_child(node_); it_ != npos; it_ = next_sibling(it_)) { ++count_; }
+			return count_;
+		}
+
+
+	private:
+		//=== Input iterator yielding {depth, value} pairs in pre-order (used by to_container) ===//
+		class depth_iterator
+		{
+		public:
+			using iterator_category  = std::input_iterator_tag;
+			using value_type         = std::pair<size_type, const T&>;
+			using difference_type    = std::ptrdiff_t;
+			using pointer            = void;
+			using reference          = value_type;
+
+		private:
+			const self_type* pTree;
+			size_type nBit;      // Position of the current '(' (or nBits at the end)
+			size_type nNode{};   // Pre-order index of the current node
+			size_type nDepth{};  // Excess before nBit
+
+		public:
+			depth_iterator(const self_type* tree_, size_type bit_) : pTree{ tree_ }, nBit{ bit_ }
+			{
+				skip_closing();
+			}
+
+			reference operator *() const
+			{
+				return { nDepth, pTree->vValues[nNode] };
+			}
+			depth_iterator& operator ++()
+			{
+				++nBit;
+				++nDepth;
+				++nNode;
+				skip_closing();
+				return *this;
+			}
+			friend bool operator ==(const depth_iterator& lhs_, const depth_iterator& rhs_)
+			{
+				return lhs_.nBit == rhs_.nBit;
+			}
+			friend bool operator !=(const depth_iterator& lhs_, const depth_iterator& rhs_)
+			{
+				return !(lhs_ == rhs_);
+			}
+
+		private:
+			// Moves past ')' bits to the next '(' (or to the end)
+			void skip_closing()
+			{
+				while ((nBit < pTree->nBits) and !pTree->bit(nBit)) {
+					++nBit;
+					--nDepth;
+				}
+			}
+		};
+
+
+	private:
+		// Checks a node index
+		size_type checked(size_type node_) const
+		{
+			if (node_ >= size()) {
+				throw std::out_of_range("Attempted to access element out of bounds.");
+			}
+			return node_;
+		}
+
+		// Returns bit i_
+		bool bit(size_type i_) const
+		{
+			return (vBits[i_ / 64u] >> (i_ % 64u)) & 1u;
+		}
+
+		// Returns the byte starting at bit i_ (i_ must be a multiple of 8)
+		unsigned byte_at(size_type i_) const
+		{
+			return static_cast<unsigned>((vBits[i_ / 64u] >> (i_ % 64u)) & 0xFFu);
+		}
+
+		// Returns the shared byte table
+		static const byte_table_type& byte_table()
+		{
+			static const byte_table_type table_;
+			return table_;
+		}
+
+		// Number of set bits of a word
+		static size_type popcount(std::uint64_t word_)
+		{
+#if defined(_MSC_VER) and defined(_M_X64)
+			return static_cast<size_type>(__popcnt64(word_));
+#elif defined(__GNUC__)
+			return static_cast<size_type>(__builtin_popcountll(word_));
+#else
+			size_type count_{};
+			for (; word_; word_ &= word_ - 1u) { ++count_; }
+			return count_;
+#endif
+		}
+
+		// Index of the lowest set bit of a non-zero word
+		static size_type lowest_bit(std::uint64_t word_)
+		{
+#if defined(_MSC_VER) and defined(_M_X64)
+			unsigned long index_{};
+			_BitScanForward64(&index_, word_);
+			return static_cast<size_type>(index_);
+#elif defined(__GNUC__)
+			return static_cast<size_type>(__builtin_ctzll(word_));
+#else
+			size_type index_{};
+			for (; !(word_ & 1u); word_ >>= 1) { ++index_; }
+			return index_;
+#endif
+		}
+
+		// Number of '(' among the first i_ bits
+		size_type rank1(size_type i_) const
+		{
+			const auto block_ = i_ / block_bits;
+			auto rank_ = vRanks[block_];
+			for (auto word_ = block_ * block_words; word_ != i_ / 64u; ++word_) { rank_ += popcount(vBits[word_]); }
+			if (i_ % 64u) { rank_ += popcount(vBits[i_ / 64u] & ((std::uint64_t{ 1 } << (i_ % 64u)) - 1u)); }
+			return rank_;
+		}
+
+		// Position of the '(' of the k_-th node (k_ < size())
+		size_type select1(size_type k_) const
+		{
+			// Last block starting with at most k_ '(' before it
+			auto block_ = static_cast<size_type>(std::upper_bound(vRanks.begin(), vRanks.end(), k_) - vRanks.begin()) - 1u;
+			auto rank_ = vRanks[block_];
+			auto word_ = block_ * block_words;
+			for (;; ++word_) {
+				const auto count_ = popcount(vBits[word_]);
+				if (rank_ + count_ > k_) { break; }
+				rank_ += count_;
+			}
+			auto bits_ = vBits[word_];
+			for (auto skip_ = k_ - rank_; skip_ != 0u; --skip_) { bits_ &= bits_ - 1u; }
+			return word_ * 64u + lowest_bit(bits_);
+		}
+
+		// Depth after the first i_ bits
+		excess_type excess(size_type i_) const
+		{
+			return 2 * static_cast<excess_type>(rank1(i_)) - static_cast<excess_type>(i_);
+		}
+
+		// Smallest j_ >= from_ with excess(j_) <= target_ (npos if none)
+		size_type fwd_search(size_type from_, excess_type target_) const
+		{
+			auto block_ = from_ / block_bits;
+			auto found_ = scan_forward(from_, excess(from_), target_);
+			if (found_ != npos) { return found_; }
+			block_ = next_block(block_, target_);
+			if (block_ == npos) { return npos; }
+			return scan_forward(block_ * block_bits, excess(block_ * block_bits), target_);
+		}
+
+		// Largest j_ <= from_ with excess(j_) <= target_ (npos if none)
+		size_type bwd_search(size_type from_, excess_type target_) const
+		{
+			auto block_ = from_ / block_bits;
+			auto found_ = scan_backward(from_, excess(from_), block_ * block_bits, target_);
+			if (found_ != npos) { return found_; }
+			block_ = prev_block(block_, target_);
+			if (block_ == npos) { return npos; }
+			const auto end_ = (std::min)((block_ + 1u) * block_bits, nBits);
+			return scan_backward(end_, excess(end_), block_ * block_bits, target_);
+		}
+
+		// Scans from j_ (with excess e_) to the end of its block
+		size_type scan_forward(size_type j_, excess_type e_, excess_type target_) const
+		{
+			const auto& table_ = byte_table();
+			const auto end_ = (std::min)((j_ / block_bits + 1u) * block_bits, nBits);
+			for (;;) {
+				if (e_ <= target_) { return j_; }
+				if (j_ == end_) { return npos; }
+				if (!(j_ % 8u) and (j_ + 8u <= end_)) {
+					const auto byte_ = byte_at(j_);
+					if (e_ + table_.min_after[byte_] > target_) {
+						e_ += table_.delta[byte_];
+						j_ += 8u;
+						continue;
+					}
+				}
+				e_ += bit(j_) ? 1 : -1;
+				++j_;
+			}
+		}
+
+		// Scans from j_ (with excess e_) down to begin_
+		size_type scan_backward(size_type j_, excess_type e_, size_type begin_, excess_type target_) const
+		{
+			const auto& table_ = byte_table();
+			for (;;) {
+				if (e_ <= target_) { return j_; }
+				if (j_ == begin_) { return npos; }
+				if (!(j_ % 8u) and (j_ >= begin_ + 8u)) {
+					const auto byte_ = byte_at(j_ - 8u);
+					if (e_ - table_.delta[byte_] + table_.min_before[byte_] > target_) {
+						e_ -= table_.delta[byte_];
+						j_ -= 8u;
+						continue;
+					}
+				}
+				--j_;
+				e_ -= bit(j_) ? 1 : -1;
+			}
+		}
+
+		// First block after block_ holding an excess <= target_ (npos if none)
+		size_type next_block(size_type block_, excess_type target_) const
+		{
+			auto i_ = nLeaves + block_;
+			for (; i_ > 1u; i_ /= 2u) {
+				if (!(i_ % 2u) and (vMinTree[i_ + 1u] <= target_)) { ++i_; break; }
+			}
+			if (i_ <= 1u) { return npos; }
+			while (i_ < nLeaves) { i_ = (vMinTree[2u * i_] <= target_) ? 2u * i_ : 2u * i_ + 1u; }
+			return i_ - nLeaves;
+		}
+
+		// Last block before block_ holding an excess <= target_ (npos if none)
+		size_type prev_block(size_type block_, excess_type target_) const
+		{
+			auto i_ = nLeaves + block_;
+			for (; i_ > 1u; i_ /= 2u) {
+				if ((i_ % 2u) and (vMinTree[i_ - 1u] <= target_)) { --i_; break; }
+			}
+			if (i_ <= 1u) { return npos; }
+			while (i_ < nLeaves) { i_ = (vMinTree[2u * i_ + 1u] <= target_) ? 2u * i_ + 1u : 2u * i_; }
+			return i_ - nLeaves;
+		}
+
+		// Position of the ')' matching the '(' at open_
+		size_type find_close(size_type open_) const
+		{
+			return fwd_search(open_ + 1u, excess(open_)) - 1u;
+		}
+
+		// Builds the rank samples and the min-tree of the block excesses
+		void build_index()
+		{
+			const auto blocks_ = (std::max)((nBits + block_bits - 1u) / block_bits, size_type{ 1 });
+			vRanks.assign(blocks_ + 1u, 0u);
+			for (size_type block_{}; block_ != blocks_; ++block_) {
+				size_type count_{};
+				for (auto word_ = block_ * block_words; word_ != (std::min)((block_ + 1u) * block_words, vBits.size()); ++word_) {
+					count_ += popcount(vBits[word_]);
+				}
+				vRanks[block_ + 1u] = vRanks[block_] + count_;
+			}
+
+			// Each leaf holds the lowest excess at positions [block start, block end] (both included)
+			nLeaves = 1u;
+			while (nLeaves < blocks_) { nLeaves *= 2u; }
+			vMinTree.assign(2u * nLeaves, (std::numeric_limits<excess_type>::max)());
+			excess_type excess_{};
+			for (size_type block_{}; block_ != blocks_; ++block_) {
+				auto min_ = excess_;
+				const auto end_ = (std::min)((block_ + 1u) * block_bits, nBits);
+				for (auto i_ = block_ * block_bits; i_ != end_; ++i_) {
+					excess_ += bit(i_) ? 1 : -1;
+					min_ = (std::min)(min_, excess_);
+				}
+				vMinTree[nLeaves + block_] = min_;
+			}
+			for (auto i_ = nLeaves - 1u; i_ > 0u; --i_) {
+				vMinTree[i_] = (std::min)(vMinTree[2u * i_], vMinTree[2u * i_ + 1u]);
+			}
+		}
+	};
+
+}
+
+
+
+// Alias for the SuccinctContainer class template in the global namespace
+template < typename T >
+using SuccinctOutTree = nsOutTree::SuccinctContainer<T>;